@@ -5,6 +5,7 @@
 #include <QStringList>
 #include <QDir>
 #include <QFileInfo>
+#include "utils/steamlocator.h"
 
 namespace Config {
     const QString APP_VERSION = "1.3.6";
@@ -37,54 +38,17 @@ namespace Config {
         return WEBSERVER_BASE_URL + "/fix/";
     }
     
-    // Steam paths - check all drives for Steam installation
-    inline QStringList getAllSteamPluginDirs() {
-        QStringList paths;
-        
-        // Common Steam installation paths to check on each drive
-        QStringList steamPaths = {
-            ":/Program Files (x86)/Steam/config/stplug-in",
-            ":/Program Files/Steam/config/stplug-in",
-            ":/Steam/config/stplug-in"
-        };
-        
-        // Check all drives from A to Z
-        for (char drive = 'A'; drive <= 'Z'; drive++) {
-            for (const QString& steamPath : steamPaths) {
-                QString fullPath = QString(drive) + steamPath;
-                QDir dir(fullPath);
-                if (dir.exists()) {
-                    paths.append(fullPath);
-                }
-            }
-        }
-        
-        return paths;
+    inline QString namesApiUrl() {
+        return WEBSERVER_BASE_URL + "/api/names";
     }
     
+    // Steam paths - discovered once by SteamLocator and cached
+    inline QStringList getAllSteamPluginDirs() {
+        return SteamLocator::instance().pluginDirs();
+    }
 
     inline QStringList getAllSteamExePaths() {
-        QStringList paths;
-        
-        // Common Steam executable paths to check on each drive
-        QStringList steamExePaths = {
-            ":/Program Files (x86)/Steam/Steam.exe",
-            ":/Program Files/Steam/Steam.exe",
-            ":/Steam/Steam.exe"
-        };
-        
-        // Check all drives from A to Z
-        for (char drive = 'A'; drive <= 'Z'; drive++) {
-            for (const QString& exePath : steamExePaths) {
-                QString fullPath = QString(drive) + exePath;
-                QFileInfo fileInfo(fullPath);
-                if (fileInfo.exists() && fileInfo.isFile()) {
-                    paths.append(fullPath);
-                }
-            }
-        }
-        
-        return paths;
+        return SteamLocator::instance().exePaths();
     }
 
     inline QString getSteamPluginDir() {
@@ -97,6 +61,7 @@ namespace Config {
              QFileInfo fi(exePaths.first());
              QString configDir = fi.absoluteDir().filePath("config");
              QDir(configDir).mkpath("stplug-in");
+             SteamLocator::instance().refresh();
              return configDir + "/stplug-in";
         }
         return "C:/Program Files (x86)/Steam/config/stplug-in";
@@ -8,6 +8,9 @@
 #include <QLinearGradient>
 #include <QRadialGradient>
 #include <QFont>
+#include <QPixmapCache>
+#include <QtMath>
+#include <functional>
 
 GameCard::GameCard(QWidget* parent)
     : QWidget(parent)
@@ -20,6 +23,7 @@ GameCard::GameCard(QWidget* parent)
 
 void GameCard::setGameData(const QMap<QString, QString>& data) {
     m_data = data;
+    m_elidedWidth = -1;
     update();
 }
 
@@ -30,6 +34,7 @@ QMap<QString, QString> GameCard::gameData() const {
 void GameCard::setThumbnail(const QPixmap& pixmap) {
     m_thumbnail = pixmap;
     m_hasThumbnail = !pixmap.isNull();
+    m_roundedThumbnail = QPixmap();
     update();
 }
 
@@ -89,233 +94,314 @@ void GameCard::updateSkeletonPulse() {
     update();
 }
 
-void GameCard::paintEvent(QPaintEvent* event) {
-    Q_UNUSED(event);
+// Everything but the thumbnail and the text is the same for every card of a
+// given size and state, so it is rasterised once into QPixmapCache and blitted.
+// Layers are split so no entry is repeated across states it doesn't depend on.
+namespace {
+    const int INSET = 4;
+    const int RADIUS = 16; // Material M3 standard
+    const int INFO_HEIGHT = 62;
+
+    enum class Frame { Resting, Hovered, Selected };
+
+    QPixmap cachedLayer(const QString& key, const QSize& size, qreal dpr,
+                        const std::function<void(QPainter&, const QRectF&)>& paint) {
+        QPixmap pixmap;
+        if (QPixmapCache::find(key, &pixmap)) return pixmap;
+        pixmap = QPixmap(QSize(qCeil(size.width() * dpr), qCeil(size.height() * dpr)));
+        pixmap.setDevicePixelRatio(dpr);
+        pixmap.fill(Qt::transparent);
+        QPainter painter(&pixmap);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        paint(painter, QRectF(QPointF(0, 0), QSizeF(size)));
+        painter.end();
+        QPixmapCache::insert(key, pixmap);
+        return pixmap;
+    }
 
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    QString layerKey(const char* layer, const QSize& size, qreal dpr, int variant = 0) {
+        return QString("gamecard/%1/%2x%3@%4/%5").arg(layer).arg(size.width()).arg(size.height()).arg(dpr).arg(variant);
+    }
 
-    QRectF cardRect = QRectF(rect()).adjusted(4, 4, -4, -4);
-    int radius = 16; // Material M3 standard
-    bool supported = (m_data.value("supported") == "true");
+    // Whole widget; the shadow spills a few pixels past the card
+    QPixmap shadowLayer(const QSize& size, qreal dpr, bool raised) {
+        return cachedLayer(layerKey("shadow", size, dpr, raised), size, dpr, [raised](QPainter& p, const QRectF& area) {
+            QRectF cardRect = area.adjusted(INSET, INSET, -INSET, -INSET);
+            p.setBrush(Qt::NoBrush);
+            if (raised) {
+                // Level 2 elevation
+                for (int i = 4; i >= 1; --i) {
+                    p.setPen(QPen(QColor(0, 0, 0, 12 * i), 0.5));
+                    p.drawRoundedRect(cardRect.adjusted(-i, -i + 1, i, i + 1), RADIUS + i, RADIUS + i);
+                }
+            } else {
+                // Level 1 elevation
+                for (int i = 2; i >= 1; --i) {
+                    p.setPen(QPen(QColor(0, 0, 0, 15 * i), 0.5));
+                    p.drawRoundedRect(cardRect.adjusted(-i, i * 0.5, i, i + 0.5), RADIUS + i, RADIUS + i);
+                }
+            }
+        });
+    }
 
-    // ── Elevation shadow ──
-    if (m_hovered || m_selected) {
-        // Level 2 elevation
-        for (int i = 4; i >= 1; --i) {
-            QColor shadowColor(0, 0, 0, 12 * i);
-            QPen shadowPen(shadowColor, 0.5);
-            painter.setPen(shadowPen);
-            painter.setBrush(Qt::NoBrush);
-            painter.drawRoundedRect(cardRect.adjusted(-i, -i + 1, i, i + 1), radius + i, radius + i);
-        }
-    } else {
-        // Level 1 elevation
-        for (int i = 2; i >= 1; --i) {
-            QColor shadowColor(0, 0, 0, 15 * i);
-            QPen shadowPen(shadowColor, 0.5);
-            painter.setPen(shadowPen);
-            painter.setBrush(Qt::NoBrush);
-            painter.drawRoundedRect(cardRect.adjusted(-i, i * 0.5, i, i + 0.5), radius + i, radius + i);
+    // Card area, shown until the thumbnail arrives
+    QPixmap placeholderLayer(const QSize& size, qreal dpr) {
+        return cachedLayer(layerKey("placeholder", size, dpr), size, dpr, [](QPainter& p, const QRectF& cardRect) {
+            QPainterPath clipPath;
+            clipPath.addRoundedRect(cardRect, RADIUS, RADIUS);
+            p.setClipPath(clipPath);
+
+            // Material surface container background
+            p.fillRect(cardRect, Colors::toQColor(Colors::SURFACE_CONTAINER_HIGH));
+
+            // Subtle tonal overlay
+            QRadialGradient glow(cardRect.center(), cardRect.height() * 0.6);
+            glow.setColorAt(0, QColor(255, 255, 255, 15)); // Soft bright tint for glass
+            glow.setColorAt(1, QColor(255, 255, 255, 0));
+            p.fillRect(cardRect, glow);
+
+            // Gamepad icon placeholder
+            QRectF iconArea(cardRect.center().x() - 28, cardRect.center().y() - 40, 56, 56);
+            QColor iconColor = Colors::toQColor(Colors::ON_SURFACE_VARIANT);
+            iconColor.setAlpha(60);
+            MaterialIcons::draw(p, iconArea, iconColor, MaterialIcons::Gamepad);
+        });
+    }
+
+    // Bottom strip behind the name, with the card's lower corners rounded off
+    QPixmap infoLayer(int width, qreal dpr, bool overThumbnail) {
+        QSize size(width, INFO_HEIGHT);
+        return cachedLayer(layerKey("info", size, dpr, overThumbnail), size, dpr, [overThumbnail](QPainter& p, const QRectF& infoRect) {
+            QPainterPath clipPath;
+            clipPath.addRoundedRect(infoRect.adjusted(0, -2 * RADIUS, 0, 0), RADIUS, RADIUS);
+            p.setClipPath(clipPath);
+
+            if (overThumbnail) {
+                // Material surface overlay for readability
+                QLinearGradient infoGrad(infoRect.topLeft(), infoRect.bottomLeft());
+                infoGrad.setColorAt(0, QColor(0, 0, 0, 0));
+                infoGrad.setColorAt(0.3, QColor(0, 0, 0, 180));
+                infoGrad.setColorAt(1, QColor(0, 0, 0, 240));
+                p.fillRect(infoRect, infoGrad);
+            } else {
+                // Flat frosted bottom
+                QColor frostedBottom = Colors::toQColor(Colors::SURFACE_CONTAINER_HIGHEST);
+                frostedBottom.setAlpha(180);
+                p.fillRect(infoRect, frostedBottom);
+                // Subtle top border relative to the bottom section
+                p.setPen(QPen(QColor(255, 255, 255, 20), 1));
+                p.drawLine(infoRect.topLeft(), infoRect.topRight());
+            }
+        });
+    }
+
+    // Whole widget: outline for the resting, hovered or selected card
+    QPixmap frameLayer(const QSize& size, qreal dpr, Frame frame) {
+        return cachedLayer(layerKey("frame", size, dpr, int(frame)), size, dpr, [frame](QPainter& p, const QRectF& area) {
+            QRectF cardRect = area.adjusted(INSET, INSET, -INSET, -INSET);
+            p.setBrush(Qt::NoBrush);
+            if (frame == Frame::Selected) {
+                // Material primary border
+                p.setPen(QPen(Colors::toQColor(Colors::PRIMARY), 2.5));
+                p.drawRoundedRect(cardRect, RADIUS, RADIUS);
+            } else if (frame == Frame::Hovered) {
+                // Subtle outline on hover
+                p.setPen(QPen(Colors::toQColor(Colors::OUTLINE), 1.2));
+                p.drawRoundedRect(cardRect, RADIUS, RADIUS);
+
+                // Top highlight shimmer
+                QPainterPath clipPath;
+                clipPath.addRoundedRect(cardRect, RADIUS, RADIUS);
+                p.setClipPath(clipPath);
+                QLinearGradient topShine(cardRect.topLeft(), QPointF(cardRect.left(), cardRect.top() + 30));
+                topShine.setColorAt(0, QColor(255, 255, 255, 12));
+                topShine.setColorAt(1, QColor(255, 255, 255, 0));
+                p.fillRect(QRectF(cardRect.left(), cardRect.top(), cardRect.width(), 30), topShine);
+            } else {
+                // Resting outline variant
+                p.setPen(QPen(Colors::toQColor(Colors::OUTLINE_VARIANT), 1));
+                p.drawRoundedRect(cardRect, RADIUS, RADIUS);
+            }
+        });
+    }
+
+    // Green check shown on supported games
+    QPixmap badgeLayer(qreal dpr) {
+        QSize size(24, 24);
+        return cachedLayer(layerKey("badge", size, dpr), size, dpr, [](QPainter& p, const QRectF& badgeRect) {
+            // Material container background
+            QPainterPath badgePath;
+            badgePath.addRoundedRect(badgeRect, 12, 12);
+            p.fillPath(badgePath, Colors::toQColor(Colors::ACCENT_GREEN));
+
+            // Check icon
+            QRectF checkRect = badgeRect.adjusted(4, 4, -4, -4);
+            QPen checkPen(QColor("#FFFFFF"), 2.2);
+            checkPen.setCapStyle(Qt::RoundCap);
+            checkPen.setJoinStyle(Qt::RoundJoin);
+            p.setPen(checkPen);
+            p.setBrush(Qt::NoBrush);
+
+            QPainterPath check;
+            check.moveTo(checkRect.left() + 1, checkRect.center().y());
+            check.lineTo(checkRect.center().x() - 1, checkRect.bottom() - 2);
+            check.lineTo(checkRect.right() - 1, checkRect.top() + 2);
+            p.drawPath(check);
+        });
+    }
+
+    // The thumbnail cut to the card's rounded corners, so painting it needs no clip
+    QPixmap roundedThumbnail(const QPixmap& thumbnail, const QSize& size, qreal dpr) {
+        QPixmap pixmap(QSize(qCeil(size.width() * dpr), qCeil(size.height() * dpr)));
+        pixmap.setDevicePixelRatio(dpr);
+        pixmap.fill(Qt::transparent);
+        QPainter p(&pixmap);
+        p.setRenderHint(QPainter::Antialiasing);
+        p.setRenderHint(QPainter::SmoothPixmapTransform);
+        QRectF cardRect(QPointF(0, 0), QSizeF(size));
+        QPainterPath clipPath;
+        clipPath.addRoundedRect(cardRect, RADIUS, RADIUS);
+        p.setClipPath(clipPath);
+        if (thumbnail.deviceIndependentSize().toSize() == size) {
+            // Pre-scaled for this card, blit as is
+            p.drawPixmap(QPointF(0, 0), thumbnail);
+        } else {
+            // Stretch thumbnail to fill card
+            p.drawPixmap(cardRect, thumbnail, thumbnail.rect());
         }
+        return pixmap;
     }
 
-    // Clip to rounded rect
-    QPainterPath clipPath;
-    clipPath.addRoundedRect(cardRect, radius, radius);
-    painter.setClipPath(clipPath);
+    const QFont& nameFont() {
+        static const QFont font = [] {
+            QFont f("Roboto", 10, QFont::DemiBold);
+            f.setStyleStrategy(QFont::PreferAntialias);
+            return f;
+        }();
+        return font;
+    }
 
-    if (m_isSkeleton) {
-        // Base skeleton background
-        QColor baseColor = Colors::toQColor(Colors::SURFACE_CONTAINER_HIGH);
-        // Blend dynamically with a slightly lighter color for the pulse
-        QColor pulseColor = Colors::toQColor(Colors::SURFACE_CONTAINER_HIGHEST);
-        
-        int r = baseColor.red() + (pulseColor.red() - baseColor.red()) * m_skeletonPulse;
-        int g = baseColor.green() + (pulseColor.green() - baseColor.green()) * m_skeletonPulse;
-        int b = baseColor.blue() + (pulseColor.blue() - baseColor.blue()) * m_skeletonPulse;
-        QColor activeColor(r, g, b);
-
-        painter.fillRect(cardRect.toRect(), activeColor);
-
-        // Draw shimmer overlay
-        QLinearGradient shimmer(cardRect.topLeft(), cardRect.bottomRight());
-        shimmer.setColorAt(0, QColor(255, 255, 255, 0));
-        shimmer.setColorAt(0.5, QColor(255, 255, 255, 10 + 15 * m_skeletonPulse));
-        shimmer.setColorAt(1, QColor(255, 255, 255, 0));
-        painter.fillRect(cardRect.toRect(), shimmer);
-
-        // Draw skeleton placeholder for thumbnail
-        QRectF thumbPlaceholder(cardRect.left(), cardRect.top(), cardRect.width(), cardRect.height() - 62);
-        QColor thumbColor = Colors::toQColor(Colors::SURFACE_VARIANT);
-        thumbColor.setAlphaF(0.4 + 0.3 * m_skeletonPulse);
-        painter.fillRect(thumbPlaceholder.toRect(), thumbColor);
-
-        // Draw skeleton placeholders for text in bottom area
-        int infoHeight = 62;
-        QRectF infoRect(cardRect.left(), cardRect.bottom() - infoHeight, cardRect.width(), infoHeight);
-        QColor infoColor = Colors::toQColor(Colors::SURFACE_CONTAINER_HIGHEST);
-        infoColor.setAlphaF(0.5 + 0.3 * m_skeletonPulse);
-        
-        // Name placeholder
-        QRectF namePlaceholder(infoRect.left() + 12, infoRect.top() + 14, infoRect.width() * 0.7, 14);
-        QPainterPath namePath;
-        namePath.addRoundedRect(namePlaceholder, 6, 6);
-        painter.fillPath(namePath, infoColor);
-
-        // ID placeholder
-        QRectF idPlaceholder(infoRect.left() + 12, infoRect.top() + 36, infoRect.width() * 0.4, 10);
-        QPainterPath idPath;
-        idPath.addRoundedRect(idPlaceholder, 5, 5);
-        painter.fillPath(idPath, infoColor);
-
-        // Reset clip for border drawing
-        painter.setClipRect(rect());
-
-        // Resting outline variant
-        QPen borderPen(Colors::toQColor(Colors::OUTLINE_VARIANT), 1);
-        painter.setPen(borderPen);
-        painter.setBrush(Qt::NoBrush);
-        painter.drawRoundedRect(cardRect, radius, radius);
+    const QFont& idFont() {
+        static const QFont font = [] {
+            QFont f("Roboto", 8);
+            f.setStyleStrategy(QFont::PreferAntialias);
+            return f;
+        }();
+        return font;
+    }
+}
 
+void GameCard::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    qreal dpr = devicePixelRatioF();
+    QRectF cardRect = QRectF(rect()).adjusted(INSET, INSET, -INSET, -INSET);
+    QSize cardSize = cardRect.size().toSize();
+
+    // ── Elevation shadow ──
+    painter.drawPixmap(QPointF(0, 0), shadowLayer(size(), dpr, m_hovered || m_selected));
+
+    if (m_isSkeleton) {
+        paintSkeleton(painter, cardRect);
         return; // Skip drawing real content
     }
 
     if (m_hasThumbnail) {
-        // Stretch thumbnail to fill card
-        painter.drawPixmap(cardRect.toRect(), m_thumbnail);
+        if (m_roundedThumbnail.isNull() || m_roundedThumbnail.deviceIndependentSize().toSize() != cardSize
+            || !qFuzzyCompare(m_roundedThumbnail.devicePixelRatio(), dpr)) {
+            m_roundedThumbnail = roundedThumbnail(m_thumbnail, cardSize, dpr);
+        }
+        painter.drawPixmap(cardRect.topLeft(), m_roundedThumbnail);
     } else {
-        // Material surface container background
-        QColor surfaceColor = Colors::toQColor(Colors::SURFACE_CONTAINER_HIGH);
-        painter.fillRect(cardRect.toRect(), surfaceColor);
-
-        // Subtle tonal overlay
-        QRadialGradient glow(cardRect.center(), cardRect.height() * 0.6);
-        glow.setColorAt(0, QColor(255, 255, 255, 15)); // Soft bright tint for glass
-        glow.setColorAt(1, QColor(255, 255, 255, 0));
-        painter.fillRect(cardRect.toRect(), glow);
-
-        // Gamepad icon placeholder
-        QRectF iconArea(
-            cardRect.center().x() - 28,
-            cardRect.center().y() - 40,
-            56, 56
-        );
-        QColor iconColor = Colors::toQColor(Colors::ON_SURFACE_VARIANT);
-        iconColor.setAlpha(60);
-        MaterialIcons::draw(painter, iconArea, iconColor, MaterialIcons::Gamepad);
+        painter.drawPixmap(cardRect.topLeft(), placeholderLayer(cardSize, dpr));
     }
 
     // ── Bottom info area ──
-    int infoHeight = 62;
-    QRectF infoRect(cardRect.left(), cardRect.bottom() - infoHeight,
-                    cardRect.width(), infoHeight);
+    QRectF infoRect(cardRect.left(), cardRect.bottom() - INFO_HEIGHT, cardRect.width(), INFO_HEIGHT);
+    painter.drawPixmap(infoRect.topLeft(), infoLayer(cardSize.width(), dpr, m_hasThumbnail));
 
-    // Material surface overlay for readability
-    QLinearGradient infoGrad(infoRect.topLeft(), infoRect.bottomLeft());
-    if (m_hasThumbnail) {
-        infoGrad.setColorAt(0, QColor(0, 0, 0, 0));
-        infoGrad.setColorAt(0.3, QColor(0, 0, 0, 180));
-        infoGrad.setColorAt(1, QColor(0, 0, 0, 240));
-        painter.fillRect(infoRect.toRect(), infoGrad);
-    } else {
-        // Flat frosted bottom
-        QColor frostedBottom = Colors::toQColor(Colors::SURFACE_CONTAINER_HIGHEST);
-        frostedBottom.setAlpha(180);
-        painter.fillRect(infoRect.toRect(), frostedBottom);
-        // Subtle top border relative to the bottom section
-        painter.setPen(QPen(QColor(255,255,255,20), 1));
-        painter.drawLine(infoRect.topLeft(), infoRect.topRight());
+    // ── Border & selection state ──
+    Frame frame = m_selected ? Frame::Selected : m_hovered ? Frame::Hovered : Frame::Resting;
+    painter.drawPixmap(QPointF(0, 0), frameLayer(size(), dpr, frame));
+
+    // ── Supported badge ──
+    if (m_data.value("supported") == "true") {
+        painter.drawPixmap(QPointF(cardRect.right() - 30, cardRect.top() + 6), badgeLayer(dpr));
     }
 
-    // Game name
-    QString name = m_data.value("name", "Unknown");
-    QFont nameFont("Roboto", 10, QFont::DemiBold);
-    nameFont.setStyleStrategy(QFont::PreferAntialias);
-    painter.setFont(nameFont);
+    // Game name, elided again only when the data or the width changes
+    QRectF nameRect(infoRect.left() + 12, infoRect.top() + 10, infoRect.width() - 24, 22);
+    if (m_elidedWidth != (int)nameRect.width()) {
+        m_elidedWidth = (int)nameRect.width();
+        m_elidedName = QFontMetrics(nameFont()).elidedText(m_data.value("name", "Unknown"), Qt::ElideRight, m_elidedWidth);
+    }
+    painter.setFont(nameFont());
     painter.setPen(Colors::toQColor(Colors::ON_SURFACE));
-
-    QRectF nameRect(infoRect.left() + 12, infoRect.top() + 10,
-                    infoRect.width() - 24, 22);
-    QFontMetrics fm(nameFont);
-    QString elidedName = fm.elidedText(name, Qt::ElideRight, (int)nameRect.width());
-    painter.drawText(nameRect, Qt::AlignLeft | Qt::AlignVCenter, elidedName);
+    painter.drawText(nameRect, Qt::AlignLeft | Qt::AlignVCenter, m_elidedName);
 
     // App ID
-    QFont idFont("Roboto", 8);
-    idFont.setStyleStrategy(QFont::PreferAntialias);
-    painter.setFont(idFont);
+    painter.setFont(idFont());
     painter.setPen(Colors::toQColor(Colors::ON_SURFACE_VARIANT));
-    QRectF idRect(infoRect.left() + 12, infoRect.top() + 34,
-                  infoRect.width() - 24, 18);
+    QRectF idRect(infoRect.left() + 12, infoRect.top() + 34, infoRect.width() - 24, 18);
     painter.drawText(idRect, Qt::AlignLeft | Qt::AlignVCenter,
                      QString("ID: %1").arg(m_data.value("appid", "?")));
+}
 
-    // Reset clip for border drawing
-    painter.setClipRect(rect());
+// Pulses every frame, so drawn directly rather than cached
+void GameCard::paintSkeleton(QPainter& painter, const QRectF& cardRect) {
+    painter.setRenderHint(QPainter::Antialiasing);
 
-    // ── Border & selection state ──
-    if (m_selected) {
-        // Material primary border
-        QPen selPen(Colors::toQColor(Colors::PRIMARY), 2.5);
-        painter.setPen(selPen);
-        painter.setBrush(Qt::NoBrush);
-        painter.drawRoundedRect(cardRect, radius, radius);
-    } else if (m_hovered) {
-        // Subtle outline on hover
-        QPen hovPen(Colors::toQColor(Colors::OUTLINE), 1.2);
-        painter.setPen(hovPen);
-        painter.setBrush(Qt::NoBrush);
-        painter.drawRoundedRect(cardRect, radius, radius);
-
-        // Top highlight shimmer
-        painter.setClipPath(clipPath);
-        QLinearGradient topShine(cardRect.topLeft(),
-                                QPointF(cardRect.left(), cardRect.top() + 30));
-        topShine.setColorAt(0, QColor(255, 255, 255, 12));
-        topShine.setColorAt(1, QColor(255, 255, 255, 0));
-        painter.fillRect(QRectF(cardRect.left(), cardRect.top(),
-                                cardRect.width(), 30), topShine);
-        painter.setClipRect(rect());
-    } else {
-        // Resting outline variant
-        QPen borderPen(Colors::toQColor(Colors::OUTLINE_VARIANT), 1);
-        painter.setPen(borderPen);
-        painter.setBrush(Qt::NoBrush);
-        painter.drawRoundedRect(cardRect, radius, radius);
-    }
+    // Clip to rounded rect
+    QPainterPath clipPath;
+    clipPath.addRoundedRect(cardRect, RADIUS, RADIUS);
+    painter.setClipPath(clipPath);
 
-    // ── Supported badge ──
-    if (supported) {
-        painter.setClipPath(clipPath);
-
-        QRectF badgeRect(cardRect.right() - 30, cardRect.top() + 6, 24, 24);
-
-        // Material container background
-        QColor badgeColor = Colors::toQColor(Colors::ACCENT_GREEN);
-        QPainterPath badgePath;
-        badgePath.addRoundedRect(badgeRect, 12, 12);
-        painter.fillPath(badgePath, badgeColor);
-
-        // Check icon
-        QRectF checkRect = badgeRect.adjusted(4, 4, -4, -4);
-        painter.setPen(Qt::NoPen);
-        painter.setBrush(Qt::NoBrush);
-
-        QPen checkPen(QColor("#FFFFFF"), 2.2);
-        checkPen.setCapStyle(Qt::RoundCap);
-        checkPen.setJoinStyle(Qt::RoundJoin);
-        painter.setPen(checkPen);
-
-        QPainterPath check;
-        check.moveTo(checkRect.left() + 1, checkRect.center().y());
-        check.lineTo(checkRect.center().x() - 1, checkRect.bottom() - 2);
-        check.lineTo(checkRect.right() - 1, checkRect.top() + 2);
-        painter.drawPath(check);
-
-        painter.setClipRect(rect());
-    }
+    // Base skeleton background
+    QColor baseColor = Colors::toQColor(Colors::SURFACE_CONTAINER_HIGH);
+    // Blend dynamically with a slightly lighter color for the pulse
+    QColor pulseColor = Colors::toQColor(Colors::SURFACE_CONTAINER_HIGHEST);
+    
+    int r = baseColor.red() + (pulseColor.red() - baseColor.red()) * m_skeletonPulse;
+    int g = baseColor.green() + (pulseColor.green() - baseColor.green()) * m_skeletonPulse;
+    int b = baseColor.blue() + (pulseColor.blue() - baseColor.blue()) * m_skeletonPulse;
+    QColor activeColor(r, g, b);
+
+    painter.fillRect(cardRect.toRect(), activeColor);
+
+    // Draw shimmer overlay
+    QLinearGradient shimmer(cardRect.topLeft(), cardRect.bottomRight());
+    shimmer.setColorAt(0, QColor(255, 255, 255, 0));
+    shimmer.setColorAt(0.5, QColor(255, 255, 255, 10 + 15 * m_skeletonPulse));
+    shimmer.setColorAt(1, QColor(255, 255, 255, 0));
+    painter.fillRect(cardRect.toRect(), shimmer);
+
+    // Draw skeleton placeholder for thumbnail
+    QRectF thumbPlaceholder(cardRect.left(), cardRect.top(), cardRect.width(), cardRect.height() - INFO_HEIGHT);
+    QColor thumbColor = Colors::toQColor(Colors::SURFACE_VARIANT);
+    thumbColor.setAlphaF(0.4 + 0.3 * m_skeletonPulse);
+    painter.fillRect(thumbPlaceholder.toRect(), thumbColor);
+
+    // Draw skeleton placeholders for text in bottom area
+    QRectF infoRect(cardRect.left(), cardRect.bottom() - INFO_HEIGHT, cardRect.width(), INFO_HEIGHT);
+    QColor infoColor = Colors::toQColor(Colors::SURFACE_CONTAINER_HIGHEST);
+    infoColor.setAlphaF(0.5 + 0.3 * m_skeletonPulse);
+    
+    // Name placeholder
+    QRectF namePlaceholder(infoRect.left() + 12, infoRect.top() + 14, infoRect.width() * 0.7, 14);
+    QPainterPath namePath;
+    namePath.addRoundedRect(namePlaceholder, 6, 6);
+    painter.fillPath(namePath, infoColor);
+
+    // ID placeholder
+    QRectF idPlaceholder(infoRect.left() + 12, infoRect.top() + 36, infoRect.width() * 0.4, 10);
+    QPainterPath idPath;
+    idPath.addRoundedRect(idPlaceholder, 5, 5);
+    painter.fillPath(idPath, infoColor);
+
+    painter.setClipping(false);
+    painter.drawPixmap(QPointF(0, 0), frameLayer(size(), devicePixelRatioF(), Frame::Resting));
 }
 
 void GameCard::mousePressEvent(QMouseEvent* event) {
@@ -6,6 +6,8 @@
 #include <QMap>
 #include <QTimer>
 
+class QPainter;
+
 class GameCard : public QWidget {
     Q_OBJECT
 
@@ -39,8 +41,13 @@ private slots:
     void updateSkeletonPulse();
 
 private:
+    void paintSkeleton(QPainter& painter, const QRectF& cardRect);
+
     QMap<QString, QString> m_data;
     QPixmap m_thumbnail;
+    QPixmap m_roundedThumbnail; // m_thumbnail clipped to the card, built on first paint
+    QString m_elidedName;
+    int m_elidedWidth = -1;     // name width m_elidedName was cut for; -1 when stale
     bool m_hasThumbnail = false;
     bool m_selected = false;
     bool m_hovered = false;
@@ -0,0 +1,303 @@
+#include "gamegridview.h"
+#include "gamecard.h"
+
+#include <QGuiApplication>
+#include <QKeyEvent>
+#include <QScrollBar>
+#include <QResizeEvent>
+#include <algorithm>
+
+namespace {
+    const int COLUMNS = 3;
+    const int MARGIN = 4;
+    const int SPACING = 14;
+    const int CARD_HEIGHT = 220;
+    const int MIN_CARD_WIDTH = 160;
+    const int ROW_STRIDE = CARD_HEIGHT + SPACING;
+    // A pause longer than this starts a new gesture; speed isn't carried over
+    const qint64 SCROLL_GESTURE_GAP_MS = 200;
+    // Above this many screens per second, prefetch two screens ahead instead of one
+    const double FAST_SCREENS_PER_SEC = 2.0;
+}
+
+GameGridView::GameGridView(QWidget* parent)
+    : QAbstractScrollArea(parent)
+{
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setFrameShape(QFrame::NoFrame);
+    viewport()->setAutoFillBackground(false);
+    setFocusPolicy(Qt::StrongFocus);
+    verticalScrollBar()->setSingleStep(40);
+}
+
+void GameGridView::setItems(const QVector<Item>& items) {
+    releaseAll();
+    m_items = items;
+    m_skeletonCount = 0;
+    m_rows.clear();
+    m_rows.reserve(m_items.size());
+    for (int i = 0; i < m_items.size(); ++i) m_rows.insert(m_items[i].value("appid"), i);
+
+    verticalScrollBar()->setValue(0);
+    // A new list is read from the top
+    m_direction = 1;
+    m_velocity = 0.0;
+    updateScrollRange();
+    relayout();
+}
+
+void GameGridView::appendItem(const Item& item) {
+    m_rows.insert(item.value("appid"), m_items.size());
+    m_items.append(item);
+    updateScrollRange();
+    relayout();
+}
+
+void GameGridView::updateItem(int index, const Item& item) {
+    if (index < 0 || index >= m_items.size()) return;
+    m_items[index] = item;
+    if (GameCard* card = m_bound.value(index)) card->setGameData(item);
+}
+
+void GameGridView::removeItem(const QString& appId) {
+    int index = indexOf(appId);
+    if (index < 0) return;
+    for (int bound : m_bound.keys()) {
+        if (bound >= index) release(bound);
+    }
+    m_items.remove(index);
+    m_rows.remove(appId);
+    for (int i = index; i < m_items.size(); ++i) m_rows.insert(m_items[i].value("appid"), i);
+    m_selected.remove(appId);
+
+    updateScrollRange();
+    relayout();
+}
+
+void GameGridView::clear() {
+    setItems(QVector<Item>());
+}
+
+void GameGridView::showSkeletons(int count) {
+    releaseAll();
+    m_items.clear();
+    m_rows.clear();
+    m_skeletonCount = count;
+    verticalScrollBar()->setValue(0);
+    updateScrollRange();
+    relayout();
+}
+
+void GameGridView::setSelection(const QStringList& appIds) {
+    m_selected = QSet<QString>(appIds.begin(), appIds.end());
+    syncSelection();
+}
+
+void GameGridView::selectAll() {
+    m_selected.clear();
+    for (const Item& item : m_items) m_selected.insert(item.value("appid"));
+    syncSelection();
+    emit selectionChanged();
+}
+
+QStringList GameGridView::selection() const {
+    // In grid order, which is also the order a batch install processes them
+    QStringList ids;
+    for (const Item& item : m_items) {
+        QString appId = item.value("appid");
+        if (m_selected.contains(appId)) ids.append(appId);
+    }
+    return ids;
+}
+
+void GameGridView::syncSelection() {
+    for (GameCard* card : m_bound) card->setSelected(m_selected.contains(card->appId()));
+}
+
+void GameGridView::setThumbnailProvider(const std::function<QPixmap(const QString&)>& provider) {
+    m_thumbnailProvider = provider;
+}
+
+void GameGridView::setThumbnail(const QString& appId, const QPixmap& pixmap) {
+    int index = indexOf(appId);
+    if (GameCard* card = m_bound.value(index)) card->setThumbnail(pixmap);
+}
+
+QStringList GameGridView::visibleAppIds() const {
+    QStringList ids;
+    for (auto it = m_bound.constBegin(); it != m_bound.constEnd(); ++it) {
+        if (!m_items.isEmpty()) ids.append(m_items[it.key()].value("appid"));
+    }
+    return ids;
+}
+
+QStringList GameGridView::upcomingAppIds() const {
+    QStringList ids;
+    if (m_items.isEmpty() || m_bound.isEmpty()) return ids;
+
+    int rowsPerScreen = qMax(1, (viewport()->height() + ROW_STRIDE - 1) / ROW_STRIDE);
+    double screensPerSec = qAbs(m_velocity) * 1000.0 / qMax(1, viewport()->height());
+    int ahead = rowsPerScreen * COLUMNS * (screensPerSec > FAST_SCREENS_PER_SEC ? 2 : 1);
+
+    QList<int> shown = m_bound.keys();
+    if (m_direction > 0) {
+        int from = *std::max_element(shown.begin(), shown.end()) + 1;
+        for (int index = from; index < qMin(m_items.size(), from + ahead); ++index) {
+            ids.append(m_items[index].value("appid"));
+        }
+    } else {
+        int from = *std::min_element(shown.begin(), shown.end()) - 1;
+        for (int index = from; index >= qMax(0, from - ahead + 1); --index) {
+            ids.append(m_items[index].value("appid"));
+        }
+    }
+    return ids;
+}
+
+QSize GameGridView::cardThumbnailSize() const {
+    // Same inset GameCard paints with
+    return QSize(cardWidth() - 8, CARD_HEIGHT - 8);
+}
+
+void GameGridView::resizeEvent(QResizeEvent* event) {
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollRange();
+    relayout();
+}
+
+void GameGridView::keyPressEvent(QKeyEvent* event) {
+    if (event->matches(QKeySequence::SelectAll) && !m_items.isEmpty()) {
+        selectAll();
+        return;
+    }
+    QAbstractScrollArea::keyPressEvent(event);
+}
+
+void GameGridView::scrollContentsBy(int dx, int dy) {
+    Q_UNUSED(dx);
+    Q_UNUSED(dy);
+    // Cards are repositioned instead of scrolling viewport pixels
+    trackScroll();
+    relayout();
+}
+
+void GameGridView::trackScroll() {
+    int offset = verticalScrollBar()->value();
+    int delta = offset - m_lastOffset;
+    m_lastOffset = offset;
+    if (delta == 0) return;
+    m_direction = delta > 0 ? 1 : -1;
+
+    qint64 elapsed = m_scrollClock.isValid() ? m_scrollClock.restart() : -1;
+    if (elapsed < 0) m_scrollClock.start();
+    if (elapsed < 0 || elapsed > SCROLL_GESTURE_GAP_MS) {
+        m_velocity = 0.0;
+        return;
+    }
+    // Wheel and drag events arrive unevenly; smooth over the last few
+    double sample = double(delta) / qMax<qint64>(1, elapsed);
+    m_velocity = 0.7 * m_velocity + 0.3 * sample;
+}
+
+int GameGridView::cardWidth() const {
+    int available = viewport()->width() - 2 * MARGIN - (COLUMNS - 1) * SPACING;
+    return qMax(MIN_CARD_WIDTH, available / COLUMNS);
+}
+
+void GameGridView::updateScrollRange() {
+    int rows = (slotCount() + COLUMNS - 1) / COLUMNS;
+    int contentHeight = rows > 0 ? 2 * MARGIN + rows * ROW_STRIDE - SPACING : 0;
+    verticalScrollBar()->setPageStep(viewport()->height());
+    verticalScrollBar()->setRange(0, qMax(0, contentHeight - viewport()->height()));
+}
+
+void GameGridView::relayout() {
+    int total = slotCount();
+    int offset = verticalScrollBar()->value();
+    int first = 0;
+    int last = -1;
+    if (total > 0) {
+        int firstRow = qMax(0, (offset - MARGIN) / ROW_STRIDE);
+        int lastRow = (offset + viewport()->height() - MARGIN) / ROW_STRIDE;
+        first = firstRow * COLUMNS;
+        last = qMin(total - 1, lastRow * COLUMNS + COLUMNS - 1);
+    }
+
+    // Return cards that scrolled out of view to the pool
+    bool changed = false;
+    for (int index : m_bound.keys()) {
+        if (index < first || index > last) {
+            release(index);
+            changed = true;
+        }
+    }
+
+    int width = cardWidth();
+    for (int index = first; index <= last; ++index) {
+        GameCard* card = m_bound.value(index);
+        if (!card) {
+            card = acquire();
+            bind(card, index);
+            m_bound.insert(index, card);
+            changed = true;
+        }
+        int row = index / COLUMNS;
+        int col = index % COLUMNS;
+        card->setGeometry(MARGIN + col * (width + SPACING), MARGIN + row * ROW_STRIDE - offset,
+                          width, CARD_HEIGHT);
+        card->show();
+    }
+
+    if (changed) emit visibleItemsChanged();
+}
+
+void GameGridView::bind(GameCard* card, int index) {
+    if (m_items.isEmpty()) {
+        card->setGameData(Item());
+        card->setThumbnail(QPixmap());
+        card->setSelected(false);
+        card->setSkeleton(true);
+        return;
+    }
+
+    const Item& item = m_items[index];
+    QString appId = item.value("appid");
+    card->setSkeleton(false);
+    card->setGameData(item);
+    card->setSelected(m_selected.contains(appId));
+    card->setThumbnail(m_thumbnailProvider ? m_thumbnailProvider(appId) : QPixmap());
+}
+
+void GameGridView::release(int index) {
+    GameCard* card = m_bound.take(index);
+    if (!card) return;
+    card->hide();
+    card->setSkeleton(false);
+    m_free.append(card);
+}
+
+void GameGridView::releaseAll() {
+    for (int index : m_bound.keys()) release(index);
+}
+
+GameCard* GameGridView::acquire() {
+    if (!m_free.isEmpty()) return m_free.takeLast();
+    GameCard* card = new GameCard(viewport());
+    connect(card, &GameCard::clicked, this, &GameGridView::onCardClicked);
+    return card;
+}
+
+void GameGridView::onCardClicked(GameCard* card) {
+    if (m_items.isEmpty()) return;
+    setFocus(Qt::MouseFocusReason);
+
+    QString appId = card->appId();
+    if (QGuiApplication::keyboardModifiers() & Qt::ControlModifier) {
+        if (m_selected.contains(appId)) m_selected.remove(appId);
+        else m_selected.insert(appId);
+    } else {
+        m_selected = { appId };
+    }
+    syncSelection();
+    emit selectionChanged();
+}
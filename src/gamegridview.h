@@ -0,0 +1,101 @@
+#ifndef GAMEGRIDVIEW_H
+#define GAMEGRIDVIEW_H
+
+#include <QAbstractScrollArea>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QPixmap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+class GameCard;
+
+// Three-column grid of game cards that only creates widgets for the rows on
+// screen. Items are plain card data maps; scrolling rebinds a small pool of
+// GameCards to whichever items are visible, so the item count can grow to
+// the whole catalogue without per-item widgets.
+class GameGridView : public QAbstractScrollArea {
+    Q_OBJECT
+
+public:
+    using Item = QMap<QString, QString>;
+
+    explicit GameGridView(QWidget* parent = nullptr);
+
+    void setItems(const QVector<Item>& items);
+    void appendItem(const Item& item);
+    void updateItem(int index, const Item& item);
+    // Later items move up; only cards from that position on are rebound
+    void removeItem(const QString& appId);
+    void clear();
+    // Placeholder cards shown while the library is syncing
+    void showSkeletons(int count);
+
+    int count() const { return m_items.size(); }
+    bool isEmpty() const { return m_items.isEmpty(); }
+    const Item& item(int index) const { return m_items.at(index); }
+    int indexOf(const QString& appId) const { return m_rows.value(appId, -1); }
+
+    // Selection follows app ids, not card widgets. Click selects one card,
+    // Ctrl+click toggles, Ctrl+A selects every item; those emit selectionChanged,
+    // setting it from code does not.
+    void setSelection(const QStringList& appIds);
+    void clearSelection() { setSelection(QStringList()); }
+    void selectAll();
+    QStringList selection() const;
+
+    // Used to fill a card's thumbnail when it is bound to an item
+    void setThumbnailProvider(const std::function<QPixmap(const QString&)>& provider);
+    void setThumbnail(const QString& appId, const QPixmap& pixmap);
+
+    QStringList visibleAppIds() const;
+    // Items just past the viewport in the direction of travel, nearest first:
+    // one screen's worth, two while scrolling fast
+    QStringList upcomingAppIds() const;
+    QSize cardThumbnailSize() const;
+
+signals:
+    void selectionChanged();
+    // Emitted whenever a different set of items comes on screen
+    void visibleItemsChanged();
+
+protected:
+    void resizeEvent(QResizeEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void scrollContentsBy(int dx, int dy) override;
+
+private:
+    int slotCount() const { return m_items.isEmpty() ? m_skeletonCount : m_items.size(); }
+    int cardWidth() const;
+    void updateScrollRange();
+    void relayout();
+    void bind(GameCard* card, int index);
+    void release(int index);
+    void releaseAll();
+    GameCard* acquire();
+    void onCardClicked(GameCard* card);
+    void syncSelection();
+    void trackScroll();
+
+    QVector<Item> m_items;
+    QHash<QString, int> m_rows;
+    int m_skeletonCount = 0;
+    QSet<QString> m_selected;
+    std::function<QPixmap(const QString&)> m_thumbnailProvider;
+
+    QHash<int, GameCard*> m_bound;
+    QList<GameCard*> m_free;
+
+    // Scroll speed in px/ms (smoothed, signed: positive is down) for prefetching
+    QElapsedTimer m_scrollClock;
+    int m_lastOffset = 0;
+    double m_velocity = 0.0;
+    int m_direction = 1;
+};
+
+#endif // GAMEGRIDVIEW_H
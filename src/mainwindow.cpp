@@ -1,6 +1,7 @@
 #include "mainwindow.h"
 #include "glassbutton.h"
 #include "gamecard.h"
+#include "gamegridview.h"
 #include "loadingspinner.h"
 #include "materialicons.h"
 #include "workers/indexdownloadworker.h"
@@ -8,8 +9,16 @@
 #include "workers/generatorworker.h"
 #include "workers/fixdownloadworker.h"
 #include "workers/restartworker.h"
+#include "workers/searchindexworker.h"
+#include "workers/batchinstallworker.h"
 #include "utils/colors.h"
 #include "utils/paths.h"
+#include "utils/thumbnailcache.h"
+#include "utils/networkclient.h"
+#include "utils/librarymodel.h"
+#include "utils/namecache.h"
+#include "utils/nameresolver.h"
+#include "utils/requestscheduler.h"
 #include "config.h"
 
 #include <QVBoxLayout>
@@ -27,12 +36,17 @@
 #include <QPixmap>
 #include <QPainterPath>
 #include <QFileDialog>
-#include <QScrollBar>
 #include <QRandomGenerator>
 #include <algorithm>
 #include <QDragEnterEvent>
 #include <QDropEvent>
 #include <QMimeData>
+#include <QScrollBar>
+
+// Fewer local hits than this and the Steam store search is queried as well
+static const int MIN_LOCAL_RESULTS = 5;
+// The grid only creates widgets for visible rows, so local results can be generous
+static const int MAX_LOCAL_RESULTS = 1000;
 
 // ── Inline helper: a QWidget that paints a single Material icon ──
 class MaterialIconWidget : public QWidget {
@@ -92,8 +106,8 @@ MainWindow::MainWindow(QWidget* parent)
     , m_dlWorker(nullptr)
     , m_genWorker(nullptr)
     , m_restartWorker(nullptr)
+    , m_batchWorker(nullptr)
     , m_fetchingNames(false)
-    , m_nameFetchSearchId(0)
 {
     setWindowTitle("Steam Lua Patcher");
     setMinimumSize(900, 600);
@@ -106,15 +120,40 @@ MainWindow::MainWindow(QWidget* parent)
     }
     
     initUI();
+
+    // Names looked up in earlier sessions; read from disk in the background
+    m_nameCache = new NameCache(this);
+
+    // Also starts looking for Steam in the background; the model follows what it finds
+    m_library = new LibraryModel(this);
+    connect(m_library, &LibraryModel::added, this, &MainWindow::onLibraryAdded);
+    connect(m_library, &LibraryModel::removed, this, &MainWindow::onLibraryRemoved);
     
     m_debounceTimer = new QTimer(this);
     m_debounceTimer->setSingleShot(true);
     connect(m_debounceTimer, &QTimer::timeout, this, &MainWindow::doSearch);
+
+    // Steam store lookups keep the old debounce so typing doesn't flood the store API
+    m_remoteSearchTimer = new QTimer(this);
+    m_remoteSearchTimer->setSingleShot(true);
+    connect(m_remoteSearchTimer, &QTimer::timeout, this, &MainWindow::doRemoteSearch);
     
     QTimer::singleShot(10, this, [this]() {
+        // Workers share this client; open the webserver connection while the UI settles
+        NetworkClient::instance().warmUp();
+
         m_networkManager = new QNetworkAccessManager(this);
         connect(m_networkManager, &QNetworkAccessManager::finished,
                 this, &MainWindow::onSearchFinished);
+
+        // Search goes out at once; names and thumbnails queue behind it by priority
+        m_scheduler = new RequestScheduler(m_networkManager, this);
+
+        m_nameResolver = new NameResolver(m_scheduler, m_nameCache, this);
+        connect(m_nameResolver, &NameResolver::resolved, this, &MainWindow::onNameResolved);
+
+        m_thumbnails = new ThumbnailCache(m_scheduler, this);
+        connect(m_thumbnails, &ThumbnailCache::thumbnailReady, this, &MainWindow::onThumbnailReady);
         startSync();
     });
 }
@@ -166,6 +205,7 @@ void MainWindow::dropEvent(QDropEvent* event) {
                 if (QFile::copy(srcPath, destPath)) {
                     count++;
                     lastFile = fileName;
+                    m_library->updateFile(QFileInfo(fileName).baseName());
                 }
             }
         }
@@ -173,9 +213,7 @@ void MainWindow::dropEvent(QDropEvent* event) {
 
     if (count > 0) {
         m_statusLabel->setText(QString("Installed %1 patch%2").arg(count).arg(count > 1 ? "es" : ""));
-        if (m_currentMode == AppMode::Library) {
-            displayLibrary();
-        } else {
+        if (m_currentMode != AppMode::Library) {
             // Switch to library to show the new patch
             m_tabLibrary->animateClick();
         }
@@ -381,29 +419,25 @@ void MainWindow::initUI() {
     m_stack->addWidget(pageLoading); // index 0
     
     // Grid page
-    m_scrollArea = new QScrollArea();
-    m_scrollArea->setWidgetResizable(true);
-    m_scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    m_scrollArea->setFrameShape(QFrame::NoFrame);
-    m_scrollArea->setStyleSheet(QString(
-        "QScrollArea { background: transparent; border: none; }"
+    m_grid = new GameGridView();
+    m_grid->setStyleSheet(QString(
+        "GameGridView { background: transparent; border: none; }"
         "QScrollBar:vertical { background: %1; width: 8px; border-radius: 4px; }"
         "QScrollBar::handle:vertical { background: %2; border-radius: 4px; min-height: 30px; }"
         "QScrollBar::handle:vertical:hover { background: %3; }"
         "QScrollBar::add-line:vertical, QScrollBar::sub-line:vertical { height: 0; }"
     ).arg(Colors::SURFACE).arg(Colors::OUTLINE_VARIANT).arg(Colors::OUTLINE));
     
-    m_gridContainer = new QWidget();
-    m_gridContainer->setStyleSheet("background: transparent;");
-    m_gridLayout = new QGridLayout(m_gridContainer);
-    m_gridLayout->setContentsMargins(4, 4, 4, 4);
-    m_gridLayout->setSpacing(14);
-    
-    m_scrollArea->setWidget(m_gridContainer);
-    connect(m_scrollArea->verticalScrollBar(), &QScrollBar::valueChanged,
-            this, &MainWindow::loadVisibleThumbnails);
+    m_grid->setThumbnailProvider([this](const QString& appId) {
+        return m_thumbnails ? m_thumbnails->cached(appId) : QPixmap();
+    });
+    connect(m_grid, &GameGridView::selectionChanged, this, &MainWindow::onSelectionChanged);
+    // Both only fire for the user's own clicks, wheel and drags
+    connect(m_grid, &GameGridView::selectionChanged, this, [this]() { m_viewTouched = true; });
+    connect(m_grid->verticalScrollBar(), &QScrollBar::actionTriggered, this, [this]() { m_viewTouched = true; });
+    connect(m_grid, &GameGridView::visibleItemsChanged, this, &MainWindow::loadVisibleThumbnails);
     
-    m_stack->addWidget(m_scrollArea); // index 1
+    m_stack->addWidget(m_grid); // index 1
     mainLayout->addWidget(m_stack);
     
     // Progress bar - Material linear progress
@@ -424,12 +458,8 @@ void MainWindow::initUI() {
 
 // ---- Helper: clear all game cards from grid ----
 void MainWindow::clearGameCards() {
-    m_selectedCard = nullptr;
-    for (GameCard* card : m_gameCards) {
-        m_gridLayout->removeWidget(card);
-        card->deleteLater();
-    }
-    m_gameCards.clear();
+    m_grid->clearSelection();
+    m_grid->clear();
 }
 
 // ---- Display random games from supported list ----
@@ -440,18 +470,21 @@ void MainWindow::displayRandomGames() {
     cancelNameFetches();
     m_pendingNameFetchIds.clear();
 
-    if (m_supportedGames.isEmpty()) return;
+    if (m_catalogue.isEmpty()) return;
 
-    QList<GameInfo> shuffled = m_supportedGames;
+    // Pick distinct random rows instead of shuffling the whole catalogue
     auto *rng = QRandomGenerator::global();
-    for (int i = shuffled.size() - 1; i > 0; --i) {
-        int j = rng->bounded(i + 1);
-        shuffled.swapItemsAt(i, j);
+    int count = qMin(12, m_catalogue.size());
+    QList<int> rows;
+    while (rows.size() < count) {
+        int row = rng->bounded(m_catalogue.size());
+        if (!rows.contains(row)) rows.append(row);
     }
 
-    int count = qMin(12, shuffled.size());
+    QVector<GameGridView::Item> items;
+    items.reserve(count);
     for (int i = 0; i < count; ++i) {
-        const GameInfo& game = shuffled[i];
+        const GameInfo game = m_catalogue.at(rows[i]);
 
         QMap<QString, QString> cd;
         cd["name"] = (game.name.isEmpty() || game.name == game.id || game.name == "Unknown Game")
@@ -463,22 +496,13 @@ void MainWindow::displayRandomGames() {
         if (game.name.isEmpty() || game.name == game.id || game.name == "Unknown Game")
             m_pendingNameFetchIds.append(game.id);
 
-        GameCard* card = new GameCard(m_gridContainer);
-        card->setGameData(cd);
-        connect(card, &GameCard::clicked, this, &MainWindow::onCardClicked);
-
-        m_gridLayout->addWidget(card, i / 3, i % 3);
-        m_gameCards.append(card);
-
-        if (m_thumbnailCache.contains(game.id)) {
-            card->setThumbnail(m_thumbnailCache[game.id]);
-        }
+        items.append(cd);
     }
+    m_grid->setItems(items);
 
-    QTimer::singleShot(50, this, &MainWindow::loadVisibleThumbnails);
     if (!m_pendingNameFetchIds.isEmpty()) startBatchNameFetch();
 
-    m_statusLabel->setText(QString("Showing %1 random games").arg(m_gameCards.count()));
+    m_statusLabel->setText(QString("Showing %1 random games").arg(m_grid->count()));
     m_stack->setCurrentIndex(1);
     m_spinner->stop();
     m_stack->setCurrentIndex(1);
@@ -493,90 +517,87 @@ void MainWindow::displayLibrary() {
     cancelNameFetches();
     m_pendingNameFetchIds.clear();
 
-    QStringList pluginDirs = Config::getAllSteamPluginDirs();
-    QSet<QString> installedAppIds;
-    
-    for (const QString& dirPath : pluginDirs) {
-        QDir dir(dirPath);
-        QStringList luaFiles = dir.entryList({"*.lua"}, QDir::Files);
-        for (const QString& file : luaFiles) {
-            QString appId = QFileInfo(file).baseName();
-            if (!appId.isEmpty()) installedAppIds.insert(appId);
-        }
-    }
-
+    // The model already knows what is installed; nothing is listed here
+    const QStringList& installedAppIds = m_library->appIds();
     if (installedAppIds.isEmpty()) {
         m_statusLabel->setText("No patches installed found.");
         m_stack->setCurrentIndex(1);
         return;
     }
 
-    int count = 0;
-    for (const QString& appId : installedAppIds) {
-        if (count >= 100) break;
+    QVector<GameGridView::Item> items;
+    items.reserve(installedAppIds.size());
+    for (const QString& appId : installedAppIds) items.append(libraryItem(appId));
+    m_grid->setItems(items);
 
-        QString name = "Unknown Game";
-        bool hasFix = false;
-        
-        for (const auto& g : m_supportedGames) {
-            if (g.id == appId) {
-                name = g.name;
-                hasFix = g.hasFix;
-                break;
-            }
-        }
+    if (!m_pendingNameFetchIds.isEmpty()) startBatchNameFetch();
 
-        if (name == "Unknown Game") m_pendingNameFetchIds.append(appId);
+    m_statusLabel->setText(QString("Found %1 installed patches").arg(m_grid->count()));
+    m_stack->setCurrentIndex(1);
+    m_spinner->stop();
+}
 
-        QMap<QString, QString> cd;
-        cd["name"] = name;
-        cd["appid"] = appId;
-        cd["supported"] = "true";
-        cd["hasFix"] = hasFix ? "true" : "false";
+QMap<QString, QString> MainWindow::libraryItem(const QString& appId) {
+    QString name = "Unknown Game";
+    bool hasFix = false;
+    
+    int row = m_catalogue.indexOf(appId);
+    if (row >= 0) {
+        name = m_catalogue.name(row);
+        hasFix = m_catalogue.hasFix(row);
+    }
 
-        GameCard* card = new GameCard(m_gridContainer);
-        card->setGameData(cd);
-        connect(card, &GameCard::clicked, this, &MainWindow::onCardClicked);
+    if (name == "Unknown Game") m_pendingNameFetchIds.append(appId);
 
-        m_gridLayout->addWidget(card, count / 3, count % 3);
-        m_gameCards.append(card);
+    QMap<QString, QString> cd;
+    cd["name"] = name;
+    cd["appid"] = appId;
+    cd["supported"] = "true";
+    cd["hasFix"] = hasFix ? "true" : "false";
+    return cd;
+}
 
-        if (m_thumbnailCache.contains(appId)) {
-            card->setThumbnail(m_thumbnailCache[appId]);
-        }
-        count++;
+// Installs and removals reach the Library view as diffs instead of a rebuild
+void MainWindow::onLibraryAdded(const QStringList& appIds) {
+    if (m_currentMode != AppMode::Library || !m_searchInput->text().trimmed().isEmpty()) return;
+    for (const QString& appId : appIds) {
+        if (m_grid->indexOf(appId) < 0) m_grid->appendItem(libraryItem(appId));
     }
-
-    QTimer::singleShot(50, this, &MainWindow::loadVisibleThumbnails);
+    m_statusLabel->setText(QString("Found %1 installed patches").arg(m_grid->count()));
     if (!m_pendingNameFetchIds.isEmpty()) startBatchNameFetch();
+}
 
-    m_statusLabel->setText(QString("Found %1 installed patches").arg(m_gameCards.count()));
-    m_stack->setCurrentIndex(1);
-    m_spinner->stop();
+void MainWindow::onLibraryRemoved(const QStringList& appIds) {
+    if (m_currentMode != AppMode::Library) return;
+    for (const QString& appId : appIds) {
+        m_grid->removeItem(appId);
+        m_pendingNameFetchIds.removeAll(appId);
+    }
+    if (appIds.contains(m_selectedGame.value("appid"))) onSelectionChanged();
+    m_statusLabel->setText(m_grid->isEmpty()
+        ? "No patches installed found."
+        : QString("Found %1 installed patches").arg(m_grid->count()));
 }
 
 // ---- Sync ----
 void MainWindow::startSync() {
-    clearGameCards();
-    
-    for (int i = 0; i < 12; ++i) {
-        GameCard* card = new GameCard(m_gridContainer);
-        card->setSkeleton(true);
-        m_gridLayout->addWidget(card, i / 3, i % 3);
-        m_gameCards.append(card);
-    }
+    m_grid->clearSelection();
+    m_grid->showSkeletons(12);
     
     m_stack->setCurrentIndex(1);
     m_spinner->stop();
     m_syncWorker = new IndexDownloadWorker(this);
-    connect(m_syncWorker, &IndexDownloadWorker::finished, this, &MainWindow::onSyncDone);
+    m_viewTouched = false;
+    connect(m_syncWorker, &IndexDownloadWorker::cacheLoaded, this, &MainWindow::onSyncDone);
+    connect(m_syncWorker, &IndexDownloadWorker::finished, this, &MainWindow::onSyncFinished);
     connect(m_syncWorker, &IndexDownloadWorker::progress, m_statusLabel, &QLabel::setText);
     connect(m_syncWorker, &IndexDownloadWorker::error, this, &MainWindow::onSyncError);
     m_syncWorker->start();
 }
 
-void MainWindow::onSyncDone(QList<GameInfo> games) {
-    m_supportedGames = games;
+void MainWindow::onSyncDone(GameCatalogue catalogue) {
+    setCatalogue(catalogue);
+
     m_spinner->stop();
     m_stack->setCurrentIndex(1);
     m_statusLabel->setText("Ready");
@@ -592,6 +613,56 @@ void MainWindow::onSyncDone(QList<GameInfo> games) {
     }
 }
 
+// The network copy usually lands after the cached one is already on screen.
+// Rebuilding then would reshuffle the cards under the user, so once they
+// have selected, scrolled or searched only the card data is brought up to date.
+void MainWindow::onSyncFinished(GameCatalogue catalogue) {
+    if (m_grid->isEmpty() || !m_viewTouched) {
+        onSyncDone(catalogue);
+        return;
+    }
+    setCatalogue(catalogue);
+    refreshGridItems();
+    m_statusLabel->setText("Library synced");
+}
+
+void MainWindow::setCatalogue(const GameCatalogue& catalogue) {
+    m_catalogue = catalogue;
+    m_catalogueGeneration++;
+
+    // Search falls back to a linear scan until the index for this catalogue is ready
+    m_searchIndex = SearchIndex();
+    SearchIndexWorker* indexWorker = new SearchIndexWorker(m_catalogue, m_catalogueGeneration, this);
+    connect(indexWorker, &SearchIndexWorker::finished, this, &MainWindow::onSearchIndexReady);
+    connect(indexWorker, &QThread::finished, indexWorker, &QObject::deleteLater);
+    indexWorker->start(QThread::LowPriority);
+}
+
+// Brings the cards already listed in line with the catalogue; only cards on
+// screen are rebound, and names resolved since are kept over placeholders
+void MainWindow::refreshGridItems() {
+    for (int index = 0; index < m_grid->count(); ++index) {
+        GameGridView::Item d = m_grid->item(index);
+        int row = m_catalogue.indexOf(d.value("appid"));
+        if (row < 0) continue;
+
+        GameGridView::Item updated = d;
+        QString name = m_catalogue.name(row);
+        if (!name.isEmpty() && name != d.value("appid") && name != "Unknown Game") updated["name"] = name;
+        updated["supported"] = "true";
+        updated["hasFix"] = m_catalogue.hasFix(row) ? "true" : "false";
+        if (updated == d) continue;
+
+        m_grid->updateItem(index, updated);
+        if (m_selectedGame.value("appid") == d.value("appid")) m_selectedGame = updated;
+    }
+}
+
+void MainWindow::onSearchIndexReady(SearchIndex index, int generation) {
+    if (generation != m_catalogueGeneration) return; // built for a superseded catalogue
+    m_searchIndex = index;
+}
+
 void MainWindow::onSyncError(QString error) {
     m_spinner->stop();
     m_stack->setCurrentIndex(1);
@@ -602,9 +673,11 @@ void MainWindow::onSyncError(QString error) {
 
 // ---- Search ----
 void MainWindow::onSearchChanged(const QString& text) {
+    m_viewTouched = true;
     m_debounceTimer->stop();
+    m_remoteSearchTimer->stop();
     if (!text.trimmed().isEmpty()) {
-        m_debounceTimer->start(400);
+        m_debounceTimer->start(m_searchIndex.isEmpty() ? 400 : 15);
     } else {
         clearGameCards();
         if (m_currentMode == AppMode::LuaPatcher) {
@@ -626,36 +699,63 @@ void MainWindow::doSearch() {
     m_currentSearchId++;
     m_statusLabel->setText("Searching...");
     
-    QJsonArray localResults;
-    int count = 0;
-    for (const auto& game : m_supportedGames) {
-        if (count >= 100) break;
-        if (m_currentMode == AppMode::FixManager && !game.hasFix) continue;
-        if (m_currentMode == AppMode::Library) {
+    bool fixesOnly = (m_currentMode == AppMode::FixManager);
+    QVector<int> rows;
+    int idRow = m_catalogue.indexOf(query);
+    if (idRow >= 0 && (!fixesOnly || m_catalogue.hasFix(idRow))) rows.append(idRow);
+
+    if (!m_searchIndex.isEmpty()) {
+        // Ranked, typo tolerant matches from the local index
+        for (const SearchIndex::Hit& hit : m_searchIndex.rankedSearch(query, MAX_LOCAL_RESULTS, [this, fixesOnly](int r) {
+                 return !fixesOnly || m_catalogue.hasFix(r);
+             })) {
+            if (hit.row != idRow) rows.append(hit.row);
         }
-        
-        if (game.name.contains(query, Qt::CaseInsensitive) || game.id == query) {
-            QJsonObject item;
-            item["id"] = game.id;
-            item["name"] = game.name;
-            item["supported_local"] = true;
-            localResults.append(item);
-            count++;
+    } else {
+        for (int row = 0; row < m_catalogue.size() && rows.size() < MAX_LOCAL_RESULTS; ++row) {
+            if (fixesOnly && !m_catalogue.hasFix(row)) continue;
+            if (row != idRow && m_catalogue.name(row).contains(query, Qt::CaseInsensitive)) rows.append(row);
         }
     }
+
+    QJsonArray localResults;
+    for (int row : rows) {
+        if (localResults.size() >= MAX_LOCAL_RESULTS) break;
+        QJsonObject item;
+        item["id"] = m_catalogue.id(row);
+        item["name"] = m_catalogue.name(row);
+        item["supported_local"] = true;
+        localResults.append(item);
+    }
     displayResults(localResults);
     
     if (m_currentMode == AppMode::FixManager) {
-        m_statusLabel->setText(m_gameCards.isEmpty()
+        m_statusLabel->setText(m_grid->isEmpty()
             ? "No fixes found for this game"
-            : QString("Found %1 games with fixes").arg(m_gameCards.count()));
+            : QString("Found %1 games with fixes").arg(m_grid->count()));
         m_stack->setCurrentIndex(1);
         m_spinner->stop();
         return;
     }
     
-    m_spinner->start();
-    if (m_gameCards.isEmpty()) m_stack->setCurrentIndex(0);
+    // Steam is only asked when the local index has little to offer
+    bool isNumeric = false;
+    query.toLongLong(&isNumeric);
+    if (isNumeric ? idRow < 0 : rows.size() < MIN_LOCAL_RESULTS) {
+        m_spinner->start();
+        if (m_grid->isEmpty()) m_stack->setCurrentIndex(0);
+        m_remoteSearchTimer->start(400);
+        return;
+    }
+
+    m_spinner->stop();
+    m_stack->setCurrentIndex(1);
+    m_statusLabel->setText(QString("Found %1 games").arg(m_grid->count()));
+}
+
+void MainWindow::doRemoteSearch() {
+    QString query = m_searchInput->text().trimmed();
+    if (query.isEmpty() || !m_networkManager) return;
     
     bool isNumeric;
     query.toInt(&isNumeric);
@@ -663,7 +763,7 @@ void MainWindow::doSearch() {
     if (isNumeric) {
         QUrl urlStore(QString("https://store.steampowered.com/api/appdetails?appids=%1").arg(query));
         QNetworkRequest reqStore(urlStore);
-        QNetworkReply* repStore = m_networkManager->get(reqStore);
+        QNetworkReply* repStore = m_scheduler->getNow(reqStore);
         repStore->setProperty("sid", m_currentSearchId);
         repStore->setProperty("type", "steam_details");
         repStore->setProperty("query_id", query);
@@ -676,7 +776,7 @@ void MainWindow::doSearch() {
         urlQuery.addQueryItem("cc", "US");
         url.setQuery(urlQuery);
         QNetworkRequest request(url);
-        m_activeReply = m_networkManager->get(request);
+        m_activeReply = m_scheduler->getNow(request);
         m_activeReply->setProperty("sid", m_currentSearchId);
         m_activeReply->setProperty("type", "store_search");
     }
@@ -694,7 +794,7 @@ void MainWindow::onSearchFinished(QNetworkReply* reply) {
     if (sid != m_currentSearchId) return;
     
     if (reply->error() != QNetworkReply::NoError) {
-        if (m_gameCards.isEmpty() && type == "store_search")
+        if (m_grid->isEmpty() && type == "store_search")
             m_statusLabel->setText("Search failed");
         return;
     }
@@ -725,7 +825,7 @@ void MainWindow::onSearchFinished(QNetworkReply* reply) {
         }
         if (!ok) {
             QUrl urlSpy(QString("https://steamspy.com/api.php?request=appdetails&appid=%1").arg(qId));
-            QNetworkReply* repSpy = m_networkManager->get(QNetworkRequest(urlSpy));
+            QNetworkReply* repSpy = m_scheduler->getNow(QNetworkRequest(urlSpy));
             repSpy->setProperty("sid", sid);
             repSpy->setProperty("type", "steamspy_details");
             return;
@@ -743,30 +843,22 @@ void MainWindow::onSearchFinished(QNetworkReply* reply) {
     m_spinner->stop();
     m_stack->setCurrentIndex(1);
     
-    QMap<QString, GameCard*> cardMap;
-    for (GameCard* c : m_gameCards) cardMap.insert(c->appId(), c);
-    
-    bool changed = false;
-    
     for (const auto& item : newItems) {
         QString id = QString::number(item["id"].toInt());
         QString name = item["name"].toString("Unknown");
         
-        bool supported = false;
-        bool hasFix = false;
-        for (const auto& g : m_supportedGames) {
-            if (g.id == id) { supported = true; hasFix = g.hasFix; break; }
-        }
+        int row = m_catalogue.indexOf(id);
+        bool supported = row >= 0;
+        bool hasFix = supported && m_catalogue.hasFix(row);
         
-        if (cardMap.contains(id)) {
-            GameCard* existing = cardMap[id];
-            QMap<QString, QString> ed = existing->gameData();
+        int index = m_grid->indexOf(id);
+        if (index >= 0) {
+            GameGridView::Item ed = m_grid->item(index);
             if (ed["name"].contains("Unknown", Qt::CaseInsensitive) || ed["name"] == id) {
                 ed["name"] = name;
                 ed["supported"] = supported ? "true" : "false";
                 ed["hasFix"] = hasFix ? "true" : "false";
-                existing->setGameData(ed);
-                changed = true;
+                m_grid->updateItem(index, ed);
             }
         } else {
             QMap<QString, QString> cd;
@@ -774,34 +866,13 @@ void MainWindow::onSearchFinished(QNetworkReply* reply) {
             cd["appid"] = id;
             cd["supported"] = supported ? "true" : "false";
             cd["hasFix"] = hasFix ? "true" : "false";
-            
-            GameCard* card = new GameCard(m_gridContainer);
-            card->setGameData(cd);
-            connect(card, &GameCard::clicked, this, &MainWindow::onCardClicked);
-            
-            int idx = m_gameCards.count();
-            m_gridLayout->addWidget(card, idx / 3, idx % 3);
-            m_gameCards.append(card);
-            cardMap.insert(id, card);
-            changed = true;
-            
-            if (m_thumbnailCache.contains(id)) {
-                card->setThumbnail(m_thumbnailCache[id]);
-            } else if (!m_activeThumbnailDownloads.contains(id)) {
-                m_activeThumbnailDownloads.insert(id);
-                QString thumbUrl = QString("https://cdn.akamai.steamstatic.com/steam/apps/%1/header.jpg").arg(id);
-                QNetworkReply* tr = m_networkManager->get(QNetworkRequest{QUrl(thumbUrl)});
-                tr->setProperty("appid", id);
-                connect(tr, &QNetworkReply::finished, this, [this, tr]() {
-                    onThumbnailDownloaded(tr);
-                });
-            }
+            m_grid->appendItem(cd);
         }
     }
     
-    m_statusLabel->setText(m_gameCards.isEmpty()
+    m_statusLabel->setText(m_grid->isEmpty()
         ? "No results found"
-        : QString("Found %1 results").arg(m_gameCards.count()));
+        : QString("Found %1 results").arg(m_grid->count()));
 }
 
 // ---- Display results as grid cards ----
@@ -814,77 +885,64 @@ void MainWindow::displayResults(const QJsonArray& items) {
 
     if (items.isEmpty()) return;
 
-    QJsonArray safeItems = items;
-    if (safeItems.size() > 120) {
-        while (safeItems.size() > 120) safeItems.removeAt(safeItems.size() - 1);
-    } 
-
-    int idx = 0;
-    for (const QJsonValue& val : safeItems) {
+    QVector<GameGridView::Item> gridItems;
+    gridItems.reserve(items.size());
+    for (const QJsonValue& val : items) {
         QJsonObject item = val.toObject();
         QString name = item["name"].toString("Unknown");
         QString appid = item.contains("id")
             ? (item["id"].isString() ? item["id"].toString() : QString::number(item["id"].toInt()))
             : "0";
         
-        bool supported = false;
-        bool hasFix = false;
-        if (item.contains("supported_local")) {
-            supported = true;
-            for (const auto& g : m_supportedGames) {
-                if (g.id == appid) { hasFix = g.hasFix; break; }
-            }
-        } else {
-            for (const auto& g : m_supportedGames) {
-                if (g.id == appid) { supported = true; hasFix = g.hasFix; break; }
-            }
-        }
+        int row = m_catalogue.indexOf(appid);
+        bool supported = item.contains("supported_local") || row >= 0;
+        bool hasFix = row >= 0 && m_catalogue.hasFix(row);
         
         QMap<QString, QString> cd;
         cd["name"] = name;
         cd["appid"] = appid;
         cd["supported"] = supported ? "true" : "false";
         cd["hasFix"] = hasFix ? "true" : "false";
-        
-        GameCard* card = new GameCard(m_gridContainer);
-        card->setGameData(cd);
-        connect(card, &GameCard::clicked, this, &MainWindow::onCardClicked);
-        
-        m_gridLayout->addWidget(card, idx / 3, idx % 3);
-        m_gameCards.append(card);
-        
-        if (m_thumbnailCache.contains(appid)) {
-            card->setThumbnail(m_thumbnailCache[appid]);
-        }
+        gridItems.append(cd);
         
         if (name.startsWith("Unknown Game") || name == "Unknown") {
             m_pendingNameFetchIds.append(appid);
         }
-        idx++;
     }
+    m_grid->setItems(gridItems);
     
     m_statusLabel->setText(QString("Found %1 results").arg(items.size()));
-    QTimer::singleShot(50, this, &MainWindow::loadVisibleThumbnails);
     
     if (!m_pendingNameFetchIds.isEmpty()) startBatchNameFetch();
 }
 
-// ---- Card clicked ----
-void MainWindow::onCardClicked(GameCard* card) {
-    if (m_selectedCard) m_selectedCard->setSelected(false);
-    
-    if (!card) {
-        m_selectedCard = nullptr;
+// ---- Card selection ----
+void MainWindow::onSelectionChanged() {
+    QStringList selection = m_grid->selection();
+    if (selection.isEmpty()) {
         m_selectedGame.clear();
         m_btnAddToLibrary->setEnabled(false);
         m_statusLabel->setText("Ready");
         return;
     }
     
-    m_selectedCard = card;
-    card->setSelected(true);
+    if (selection.size() > 1) {
+        // Only patch installs can run for several games at once
+        m_selectedGame.clear();
+        if (m_currentMode == AppMode::LuaPatcher) {
+            m_btnAddToLibrary->setEnabled(true);
+            m_btnAddToLibrary->setDescription(QString("Install patches for %1 games").arg(selection.size()));
+            m_btnAddToLibrary->setColor(Colors::ACCENT_GREEN);
+        } else if (m_currentMode == AppMode::FixManager) {
+            m_btnApplyFix->setEnabled(false);
+        } else if (m_currentMode == AppMode::Library) {
+            m_btnRemove->setEnabled(false);
+        }
+        m_statusLabel->setText(QString("Selected %1 games").arg(selection.size()));
+        return;
+    }
     
-    QMap<QString, QString> data = card->gameData();
+    QMap<QString, QString> data = m_grid->item(m_grid->indexOf(selection.first()));
     m_selectedGame = data;
     bool hasFix = (data["hasFix"] == "true");
     bool isSupported = (data["supported"] == "true");
@@ -914,6 +972,10 @@ void MainWindow::onCardClicked(GameCard* card) {
 
 // ---- Patch / Generate / Restart / Fix / Remove ----
 void MainWindow::doAddGame() {
+    if (m_grid->selection().size() > 1) {
+        runBatchInstall();
+        return;
+    }
     if (m_selectedGame.isEmpty()) return;
     bool isSupported = (m_selectedGame["supported"] == "true");
     if (isSupported) runPatchLogic(); else runGenerateLogic();
@@ -940,8 +1002,8 @@ void MainWindow::doRemoveGame() {
     }
     
     if (deleted) {
+        m_library->updateFile(appId);
         m_statusLabel->setText(QString("Removed patch for %1").arg(name));
-        displayLibrary();
     } else {
         QMessageBox::warning(this, "Error", "Failed to remove patch file. It may not exist or is in use.");
     }
@@ -955,7 +1017,9 @@ void MainWindow::runPatchLogic() {
     m_terminalDialog->appendLog(QString("Initializing patch for: %1").arg(m_selectedGame["name"]), "INFO");
     m_terminalDialog->show();
     
-    m_dlWorker = new LuaDownloadWorker(m_selectedGame["appid"], this);
+    int row = m_catalogue.indexOf(m_selectedGame["appid"]);
+    QByteArray sha256 = row >= 0 ? m_catalogue.sha256(row) : QByteArray();
+    m_dlWorker = new LuaDownloadWorker(m_selectedGame["appid"], sha256, this);
     connect(m_dlWorker, &LuaDownloadWorker::finished, this, &MainWindow::onPatchDone);
     connect(m_dlWorker, &LuaDownloadWorker::progress, [this](qint64 dl, qint64 total) {
         if (total > 0) m_progress->setValue(static_cast<int>(dl * 100 / total));
@@ -966,6 +1030,56 @@ void MainWindow::runPatchLogic() {
     m_dlWorker->start();
 }
 
+void MainWindow::runBatchInstall() {
+    // Unsupported games have no patch on the server and need Generate instead
+    QStringList appIds;
+    QStringList skipped;
+    QHash<QString, QByteArray> hashes;
+    for (const QString& appId : m_grid->selection()) {
+        int row = m_catalogue.indexOf(appId);
+        if (row >= 0) {
+            appIds.append(appId);
+            hashes.insert(appId, m_catalogue.sha256(row));
+        } else {
+            skipped.append(appId);
+        }
+    }
+    
+    m_terminalDialog->clear();
+    m_terminalDialog->appendLog(QString("Initializing batch install for %1 games").arg(appIds.size()), "INFO");
+    if (!skipped.isEmpty()) {
+        m_terminalDialog->appendLog(QString("Skipping %1 unsupported games: %2")
+                                    .arg(skipped.size()).arg(skipped.join(", ")), "WARN");
+    }
+    m_terminalDialog->show();
+    if (appIds.isEmpty()) {
+        onPatchError("None of the selected games are supported");
+        return;
+    }
+    
+    m_btnAddToLibrary->setEnabled(false);
+    m_progress->setValue(0);
+    
+    m_batchWorker = new BatchInstallWorker(appIds, hashes, 4, this);
+    connect(m_batchWorker, &BatchInstallWorker::finished, this, [this](QStringList installed, QStringList failed) {
+        m_progress->hide();
+        m_btnAddToLibrary->setEnabled(true);
+        for (const QString& appId : installed) m_library->updateFile(appId);
+        m_statusLabel->setText(QString("Installed %1 of %2 patches").arg(installed.size()).arg(installed.size() + failed.size()));
+        if (!failed.isEmpty()) {
+            m_terminalDialog->appendLog(QString("Failed: %1").arg(failed.join(", ")), "WARN");
+        }
+        m_terminalDialog->setFinished(failed.isEmpty());
+    });
+    connect(m_batchWorker, &BatchInstallWorker::progress, [this](qint64 done, qint64 total) {
+        if (total > 0) m_progress->setValue(static_cast<int>(done * 100 / total));
+    });
+    connect(m_batchWorker, &BatchInstallWorker::status, [this](QString msg) { m_statusLabel->setText(msg); });
+    connect(m_batchWorker, &BatchInstallWorker::log, m_terminalDialog, &TerminalDialog::appendLog);
+    connect(m_batchWorker, &BatchInstallWorker::error, this, &MainWindow::onPatchError);
+    m_batchWorker->start();
+}
+
 void MainWindow::onPatchDone(QString path) {
     try {
         m_terminalDialog->appendLog("Patch file downloaded. Installing...", "INFO");
@@ -995,7 +1109,8 @@ void MainWindow::onPatchDone(QString path) {
             else { lastErr = "Failed to copy patch file to " + pluginDir; m_terminalDialog->appendLog(lastErr, "ERROR"); }
         }
         if (!ok) throw std::runtime_error(lastErr.toStdString());
-        QFile::remove(path);
+        m_library->updateFile(m_selectedGame["appid"]);
+        // path is in the patch store and stays there for reinstalls
         m_progress->hide();
         m_btnAddToLibrary->setEnabled(true);
         m_statusLabel->setText("Patch Installed!");
@@ -1028,14 +1143,12 @@ void MainWindow::runGenerateLogic() {
         m_btnAddToLibrary->setEnabled(true);
         m_statusLabel->setText("Patch Generated & Installed!");
         m_terminalDialog->setFinished(true);
-        QString appId = m_selectedGame["appid"];
-        for (GameCard* card : m_gameCards) {
-            if (card->appId() == appId) {
-                QMap<QString, QString> d = card->gameData();
-                d["supported"] = "true";
-                card->setGameData(d);
-                break;
-            }
+        m_library->updateFile(m_selectedGame["appid"]);
+        int index = m_grid->indexOf(m_selectedGame["appid"]);
+        if (index >= 0) {
+            GameGridView::Item d = m_grid->item(index);
+            d["supported"] = "true";
+            m_grid->updateItem(index, d);
         }
         m_btnAddToLibrary->setDescription(QString("Re-patch %1").arg(m_selectedGame["name"]));
         m_btnAddToLibrary->setColor(Colors::ACCENT_GREEN);
@@ -1087,16 +1200,18 @@ void MainWindow::doApplyFix() {
 }
 
 // ---- Mode switching ----
+// Only stops waiting: lookups already sent finish and are cached for the next view
 void MainWindow::cancelNameFetches() {
     m_fetchingNames = false;
-    for (QNetworkReply* r : m_activeNameFetches) { if (r) { r->abort(); r->deleteLater(); } }
-    m_activeNameFetches.clear();
+    m_awaitingNames.clear();
     m_pendingNameFetchIds.clear();
+    if (m_nameResolver) m_nameResolver->clearQueue();
 }
 
 void MainWindow::switchMode(AppMode mode) {
     if (m_currentMode == mode) return;
     m_currentMode = mode;
+    m_viewTouched = true;
     updateModeUI();
     
     m_btnAddToLibrary->hide();
@@ -1111,7 +1226,8 @@ void MainWindow::switchMode(AppMode mode) {
         m_btnRemove->show();
     }
     
-    onCardClicked(nullptr);
+    m_grid->clearSelection();
+    onSelectionChanged();
     clearGameCards();
     if (m_currentMode == AppMode::FixManager) {
         populateFixList();
@@ -1132,10 +1248,9 @@ void MainWindow::populateFixList() {
     m_pendingNameFetchIds.clear();
     
     QJsonArray fixGames;
-    int count = 0;
-    for (const auto& game : m_supportedGames) {
-        if (count >= 100) break;
-        if (game.hasFix) {
+    for (int row = 0; row < m_catalogue.size(); ++row) {
+        if (m_catalogue.hasFix(row)) {
+            const GameInfo game = m_catalogue.at(row);
             QJsonObject item;
             item["id"] = game.id;
             item["name"] = (game.name.isEmpty() || game.name == game.id || game.name == "Unknown Game")
@@ -1144,14 +1259,13 @@ void MainWindow::populateFixList() {
                 m_pendingNameFetchIds.append(game.id);
             item["supported_local"] = true;
             fixGames.append(item);
-            count++;
         }
     }
     displayResults(fixGames);
     if (!m_pendingNameFetchIds.isEmpty()) startBatchNameFetch();
-    m_statusLabel->setText(m_gameCards.isEmpty()
+    m_statusLabel->setText(m_grid->isEmpty()
         ? "No fixes available in current index."
-        : QString("Found %1 available fixes").arg(m_gameCards.count()));
+        : QString("Found %1 available fixes").arg(m_grid->count()));
     m_stack->setCurrentIndex(1);
     m_spinner->stop();
 }
@@ -1164,119 +1278,64 @@ void MainWindow::updateModeUI() {
 }
 
 // ---- Batch name fetch ----
+// Hands the ids the view is missing names for to the resolver. Ids other views
+// already asked for are joined, cached ones come back before request() returns.
 void MainWindow::startBatchNameFetch() {
-    if (m_pendingNameFetchIds.isEmpty()) { m_fetchingNames = false; m_spinner->stop(); return; }
+    if (!m_nameResolver) return;
+    QStringList appIds = m_pendingNameFetchIds;
+    m_pendingNameFetchIds.clear();
+    for (const QString& appId : appIds) m_awaitingNames.insert(appId);
     m_fetchingNames = true;
-    m_nameFetchSearchId = m_currentSearchId;
+    // Names for cards on screen first, the rest of the result list after everything else
+    QSet<QString> visible;
+    for (const QString& appId : m_grid->visibleAppIds()) visible.insert(appId);
+    QStringList now, later;
+    for (const QString& appId : appIds) (visible.contains(appId) ? now : later).append(appId);
+    m_nameResolver->request(now, RequestScheduler::Visible);
+    m_nameResolver->request(later, RequestScheduler::Background);
+    if (m_awaitingNames.isEmpty()) {
+        m_fetchingNames = false;
+        m_spinner->stop();
+        return;
+    }
     m_spinner->start();
-    m_statusLabel->setText(QString("Found %1 results %2 Fetching game names...").arg(m_gameCards.count()).arg(QChar(0x2022)));
-    for (int i = 0; i < 5 && !m_pendingNameFetchIds.isEmpty(); ++i) processNextNameFetch();
+    m_statusLabel->setText(QString("Found %1 results %2 Fetching game names...").arg(m_grid->count()).arg(QChar(0x2022)));
 }
 
-void MainWindow::processNextNameFetch() {
-    if (m_pendingNameFetchIds.isEmpty() || !m_fetchingNames) {
-        if (m_activeNameFetches.isEmpty() && m_fetchingNames) {
-            m_fetchingNames = false; m_spinner->stop();
-            m_statusLabel->setText(QString("Found %1 results").arg(m_gameCards.count()));
-        }
-        return;
-    }
-    QString appId = m_pendingNameFetchIds.takeFirst();
-    QUrl url(QString("https://store.steampowered.com/api/appdetails?appids=%1").arg(appId));
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::UserAgentHeader, "SteamLuaPatcher/2.0");
-    QNetworkReply* reply = m_networkManager->get(request);
-    reply->setProperty("fetch_appid", appId);
-    reply->setProperty("fetch_type", "steam_store");
-    reply->setProperty("fetch_sid", m_nameFetchSearchId);
-    m_activeNameFetches.append(reply);
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() { onGameNameFetched(reply); });
+// Every answer goes to whichever card shows the id, whoever asked for it
+void MainWindow::onNameResolved(const QString& appId, const QString& name) {
+    if (!name.isEmpty()) applyGameName(appId, name);
+    if (!m_awaitingNames.remove(appId) || !m_awaitingNames.isEmpty() || !m_fetchingNames) return;
+    m_fetchingNames = false;
+    m_spinner->stop();
+    m_statusLabel->setText(QString("Found %1 results").arg(m_grid->count()));
 }
 
-void MainWindow::onGameNameFetched(QNetworkReply* reply) {
-    reply->deleteLater();
-    m_activeNameFetches.removeOne(reply);
-    int fetchSid = reply->property("fetch_sid").toInt();
-    if (fetchSid != m_nameFetchSearchId || !m_fetchingNames) { processNextNameFetch(); return; }
-    
-    QString appId = reply->property("fetch_appid").toString();
-    QString fetchType = reply->property("fetch_type").toString();
-    QString gameName;
-    
-    if (reply->error() == QNetworkReply::NoError) {
-        QJsonObject obj = QJsonDocument::fromJson(reply->readAll()).object();
-        if (fetchType == "steam_store") {
-            if (obj.contains(appId)) {
-                QJsonObject root = obj[appId].toObject();
-                if (root["success"].toBool() && root.contains("data"))
-                    gameName = root["data"].toObject()["name"].toString();
-            }
-        } else if (fetchType == "steamspy") {
-            if (obj.contains("name") && !obj["name"].toString().isEmpty())
-                gameName = obj["name"].toString();
-        }
-    }
-    
-    if (gameName.isEmpty() && fetchType == "steam_store") {
-        QUrl spyUrl(QString("https://steamspy.com/api.php?request=appdetails&appid=%1").arg(appId));
-        QNetworkRequest req(spyUrl);
-        req.setHeader(QNetworkRequest::UserAgentHeader, "SteamLuaPatcher/2.0");
-        QNetworkReply* spyReply = m_networkManager->get(req);
-        spyReply->setProperty("fetch_appid", appId);
-        spyReply->setProperty("fetch_type", "steamspy");
-        spyReply->setProperty("fetch_sid", m_nameFetchSearchId);
-        m_activeNameFetches.append(spyReply);
-        connect(spyReply, &QNetworkReply::finished, this, [this, spyReply]() { onGameNameFetched(spyReply); });
-        return;
-    }
-    
-    if (!gameName.isEmpty()) {
-        for (GameCard* card : m_gameCards) {
-            if (card->appId() == appId) {
-                QMap<QString, QString> d = card->gameData();
-                d["name"] = gameName;
-                card->setGameData(d);
-                break;
-            }
-        }
-    }
-    processNextNameFetch();
+void MainWindow::applyGameName(const QString& appId, const QString& name) {
+    int index = m_grid->indexOf(appId);
+    if (index < 0) return;
+    GameGridView::Item d = m_grid->item(index);
+    d["name"] = name;
+    m_grid->updateItem(index, d);
 }
 
 // ---- Thumbnail lazy loading ----
 void MainWindow::loadVisibleThumbnails() {
-    if (!m_scrollArea || !m_networkManager) return;
-    QRect visibleRect = m_scrollArea->viewport()->rect();
-    
-    for (GameCard* card : m_gameCards) {
-        QPoint pos = m_gridContainer->mapTo(m_scrollArea->viewport(), card->geometry().topLeft());
-        QRect cardInView(pos, card->size());
-        if (!visibleRect.intersects(cardInView)) continue;
-        
-        QString appId = card->appId();
-        if (appId.isEmpty() || card->hasThumbnail()) continue;
-        if (m_thumbnailCache.contains(appId)) { card->setThumbnail(m_thumbnailCache[appId]); continue; }
-        if (m_activeThumbnailDownloads.contains(appId)) continue;
-        
-        m_activeThumbnailDownloads.insert(appId);
-        QString thumbUrl = QString("https://cdn.akamai.steamstatic.com/steam/apps/%1/header.jpg").arg(appId);
-        QNetworkReply* tr = m_networkManager->get(QNetworkRequest{QUrl(thumbUrl)});
-        tr->setProperty("appid", appId);
-        connect(tr, &QNetworkReply::finished, this, [this, tr]() { onThumbnailDownloaded(tr); });
+    if (!m_thumbnails) return;
+    // All cards in the grid share one size; decode straight to it
+    m_thumbnails->setTargetSize(m_grid->cardThumbnailSize(), devicePixelRatioF());
+    
+    // Cards about to scroll in are fetched ahead so they bind with their image
+    QStringList visible = m_grid->visibleAppIds();
+    m_thumbnails->setViewport(visible, m_grid->upcomingAppIds());
+    QStringList unnamed;
+    for (const QString& appId : visible) {
+        if (m_awaitingNames.contains(appId)) unnamed.append(appId);
     }
+    // Names queued in the background move up once their card scrolls into view
+    if (m_nameResolver && !unnamed.isEmpty()) m_nameResolver->request(unnamed, RequestScheduler::Visible);
 }
 
-void MainWindow::onThumbnailDownloaded(QNetworkReply* reply) {
-    reply->deleteLater();
-    QString appId = reply->property("appid").toString();
-    m_activeThumbnailDownloads.remove(appId);
-    if (reply->error() != QNetworkReply::NoError || appId.isEmpty()) return;
-    
-    QPixmap pixmap;
-    if (pixmap.loadFromData(reply->readAll())) {
-        m_thumbnailCache[appId] = pixmap;
-        for (GameCard* card : m_gameCards) {
-            if (card->appId() == appId) { card->setThumbnail(pixmap); break; }
-        }
-    }
+void MainWindow::onThumbnailReady(const QString& appId, const QPixmap& pixmap) {
+    m_grid->setThumbnail(appId, pixmap);
 }
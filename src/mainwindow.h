@@ -13,13 +13,13 @@
 #include <QTimer>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
-#include <QScrollArea>
-#include <QGridLayout>
 #include <QSet>
 
 class GlassButton;
-class GameCard;
+class GameGridView;
 #include "utils/gameinfo.h"
+#include "utils/gamecatalogue.h"
+#include "utils/searchindex.h"
 #include "terminaldialog.h"
 
 class LoadingSpinner;
@@ -29,6 +29,12 @@ class LuaDownloadWorker;
 class RestartWorker;
 class GeneratorWorker;
 class FixDownloadWorker;
+class BatchInstallWorker;
+class ThumbnailCache;
+class LibraryModel;
+class NameCache;
+class NameResolver;
+class RequestScheduler;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -49,16 +55,20 @@ protected:
     void dropEvent(QDropEvent* event) override;
 
 private slots:
-    void onSyncDone(QList<GameInfo> games);
+    void onSyncDone(GameCatalogue catalogue);
+    void onSyncFinished(GameCatalogue catalogue);
     void onSyncError(QString error);
     void onSearchChanged(const QString& text);
     void doSearch();
+    void doRemoteSearch();
+    void onSearchIndexReady(SearchIndex index, int generation);
     void onSearchFinished(QNetworkReply* reply);
-    void onGameNameFetched(QNetworkReply* reply);
-    void onThumbnailDownloaded(QNetworkReply* reply);
-    void onCardClicked(GameCard* card);
+    void onNameResolved(const QString& appId, const QString& name);
+    void onThumbnailReady(const QString& appId, const QPixmap& pixmap);
+    void onSelectionChanged();
     void doAddGame();
     void runPatchLogic();
+    void runBatchInstall();
     void runGenerateLogic();
     void onPatchDone(QString path);
     void onPatchError(QString error);
@@ -67,19 +77,24 @@ private slots:
     void doRemoveGame();
     void switchMode(AppMode mode);
     void updateModeUI();
-    void processNextNameFetch();
     void populateFixList();
     void loadVisibleThumbnails();
 
 private:
     void initUI();
     void startSync();
+    void setCatalogue(const GameCatalogue& catalogue);
+    void refreshGridItems();
     void displayResults(const QJsonArray& items);
     void startBatchNameFetch();
+    void applyGameName(const QString& appId, const QString& name);
     void cancelNameFetches();
     void clearGameCards();
     void displayRandomGames();
     void displayLibrary();
+    QMap<QString, QString> libraryItem(const QString& appId);
+    void onLibraryAdded(const QStringList& appIds);
+    void onLibraryRemoved(const QStringList& appIds);
 
     // UI Components
     QLabel* m_statusLabel;
@@ -89,11 +104,7 @@ private:
     QProgressBar* m_progress;
     
     // Grid components
-    QScrollArea* m_scrollArea;
-    QWidget* m_gridContainer;
-    QGridLayout* m_gridLayout;
-    QList<GameCard*> m_gameCards;
-    GameCard* m_selectedCard = nullptr;
+    GameGridView* m_grid;
     
     // Header & Tabs
     GlassButton* m_tabLua;
@@ -108,15 +119,20 @@ private:
     TerminalDialog* m_terminalDialog;
 
     // Data
-    QList<GameInfo> m_supportedGames;
+    GameCatalogue m_catalogue;
+    SearchIndex m_searchIndex;
+    int m_catalogueGeneration = 0;
+    bool m_viewTouched = false; // selected, scrolled or searched since the last sync started
     QMap<QString, QString> m_selectedGame;
     
     // Network
     QNetworkAccessManager* m_networkManager;
     QNetworkReply* m_activeReply;
+    RequestScheduler* m_scheduler = nullptr;
     
     // Search debounce
     QTimer* m_debounceTimer;
+    QTimer* m_remoteSearchTimer;
     int m_currentSearchId;
     
     // Workers
@@ -125,15 +141,18 @@ private:
     GeneratorWorker* m_genWorker;
     FixDownloadWorker* m_fixWorker;
     RestartWorker* m_restartWorker;
+    BatchInstallWorker* m_batchWorker;
     
     // Batch name fetching
     QStringList m_pendingNameFetchIds;
-    QList<QNetworkReply*> m_activeNameFetches;
+    QSet<QString> m_awaitingNames; // asked for by the current view, not answered yet
     bool m_fetchingNames;
-    int m_nameFetchSearchId;
+    NameCache* m_nameCache = nullptr;
+    NameResolver* m_nameResolver = nullptr;
     // Thumbnail cache
-    QMap<QString, QPixmap> m_thumbnailCache;
-    QSet<QString> m_activeThumbnailDownloads;
+    ThumbnailCache* m_thumbnails = nullptr;
+    // Installed patches, kept current by watching the plugin folders
+    LibraryModel* m_library = nullptr;
 };
 
 #endif // MAINWINDOW_H
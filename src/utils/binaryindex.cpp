@@ -0,0 +1,237 @@
+#include "binaryindex.h"
+#include <QSaveFile>
+#include <QHash>
+#include <QVector>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    const char MAGIC[4] = { 'S', 'L', 'P', 'I' };
+    const quint32 FORMAT_VERSION = 2;
+    const int DIGEST_SIZE = 20;
+    const int HASH_SIZE = 32;
+    const qint64 HEADER_SIZE = 56;
+
+    inline quint32 readU32(const uchar* base, quint32 i) {
+        return qFromLittleEndian<quint32>(base + i * 4);
+    }
+
+    inline void appendU32(QByteArray& out, quint32 value) {
+        uchar buf[4];
+        qToLittleEndian<quint32>(value, buf);
+        out.append(reinterpret_cast<const char*>(buf), 4);
+    }
+}
+
+BinaryIndex::~BinaryIndex() {
+    close();
+}
+
+bool BinaryIndex::open(const QString& path) {
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) return false;
+
+    m_size = m_file.size();
+    if (m_size < HEADER_SIZE) { close(); return false; }
+
+    const uchar* data = m_file.map(0, m_size);
+    if (!data) { close(); return false; }
+
+    if (std::memcmp(data, MAGIC, 4) != 0 || readU32(data, 1) != FORMAT_VERSION) {
+        m_file.unmap(const_cast<uchar*>(data));
+        close();
+        return false;
+    }
+
+    quint32 count = readU32(data, 2);
+    quint32 stringCount = readU32(data, 3);
+    quint32 poolSize = readU32(data, 4);
+    quint32 bitsetWords = (count + 31) / 32;
+
+    qint64 expected = HEADER_SIZE
+        + qint64(count) * 4            // appIds
+        + qint64(count) * 4            // nameIds
+        + (qint64(stringCount) + 1) * 4
+        + qint64(bitsetWords) * 4
+        + qint64(count) * HASH_SIZE
+        + poolSize;
+    if (expected != m_size) {
+        m_file.unmap(const_cast<uchar*>(data));
+        close();
+        return false;
+    }
+
+    m_data = data;
+    m_count = count;
+    m_stringCount = stringCount;
+    m_poolSize = poolSize;
+    m_generatedAt = qFromLittleEndian<qint64>(data + 24);
+
+    m_appIds = data + HEADER_SIZE;
+    m_nameIds = m_appIds + count * 4;
+    m_strOffsets = m_nameIds + count * 4;
+    m_hasFix = m_strOffsets + (stringCount + 1) * 4;
+    m_hashes = m_hasFix + bitsetWords * 4;
+    m_pool = reinterpret_cast<const char*>(m_hashes + count * HASH_SIZE);
+    return true;
+}
+
+void BinaryIndex::close() {
+    if (m_data) {
+        m_file.unmap(const_cast<uchar*>(m_data));
+    }
+    if (m_file.isOpen()) m_file.close();
+    m_data = nullptr;
+    m_size = 0;
+    m_count = 0;
+    m_stringCount = 0;
+    m_poolSize = 0;
+    m_generatedAt = 0;
+    m_appIds = m_nameIds = m_strOffsets = m_hasFix = m_hashes = nullptr;
+    m_pool = nullptr;
+}
+
+quint32 BinaryIndex::appIdAt(int i) const {
+    if (!m_data || i < 0 || quint32(i) >= m_count) return 0;
+    return readU32(m_appIds, quint32(i));
+}
+
+QString BinaryIndex::nameAt(int i) const {
+    if (!m_data || i < 0 || quint32(i) >= m_count) return QString();
+    quint32 sid = readU32(m_nameIds, quint32(i));
+    if (sid >= m_stringCount) return QString();
+    quint32 begin = readU32(m_strOffsets, sid);
+    quint32 end = readU32(m_strOffsets, sid + 1);
+    if (begin > end || end > m_poolSize) return QString();
+    return QString::fromUtf8(m_pool + begin, int(end - begin));
+}
+
+bool BinaryIndex::hasFixAt(int i) const {
+    if (!m_data || i < 0 || quint32(i) >= m_count) return false;
+    quint32 word = readU32(m_hasFix, quint32(i) / 32);
+    return (word >> (quint32(i) % 32)) & 1u;
+}
+
+QByteArray BinaryIndex::sha256At(int i) const {
+    if (!m_data || i < 0 || quint32(i) >= m_count) return QByteArray();
+    QByteArray digest(reinterpret_cast<const char*>(m_hashes + qint64(i) * HASH_SIZE), HASH_SIZE);
+    return digest == QByteArray(HASH_SIZE, '\0') ? QByteArray() : digest;
+}
+
+int BinaryIndex::indexOf(quint32 appId) const {
+    int lo = 0;
+    int hi = count() - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        quint32 value = readU32(m_appIds, quint32(mid));
+        if (value == appId) return mid;
+        if (value < appId) lo = mid + 1; else hi = mid - 1;
+    }
+    return -1;
+}
+
+QByteArray BinaryIndex::sourceDigest() const {
+    if (!m_data) return QByteArray();
+    return QByteArray(reinterpret_cast<const char*>(m_data + 32), DIGEST_SIZE);
+}
+
+QList<GameInfo> BinaryIndex::toGameList() const {
+    QList<GameInfo> games;
+    games.reserve(count());
+    for (int i = 0; i < count(); ++i) {
+        GameInfo game;
+        game.id = QString::number(appIdAt(i));
+        game.name = nameAt(i);
+        game.hasFix = hasFixAt(i);
+        game.sha256 = sha256At(i);
+        games.append(game);
+    }
+    return games;
+}
+
+bool BinaryIndex::write(const QString& path, const QList<GameInfo>& games,
+                        qint64 generatedAt, const QByteArray& sourceDigest) {
+    // Sort by numeric appid; Steam ids are always numeric, anything else
+    // means the index is not ours and we keep using the JSON form.
+    struct Row { quint32 appId; int source; };
+    QVector<Row> rows;
+    rows.reserve(games.size());
+    for (int i = 0; i < games.size(); ++i) {
+        bool ok = false;
+        quint32 appId = games[i].id.toUInt(&ok);
+        if (!ok) return false;
+        rows.append({ appId, i });
+    }
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](const Row& a, const Row& b) { return a.appId < b.appId; });
+    rows.erase(std::unique(rows.begin(), rows.end(),
+                           [](const Row& a, const Row& b) { return a.appId == b.appId; }),
+               rows.end());
+
+    // Intern names into a single pool
+    QHash<QString, quint32> interned;
+    QVector<quint32> nameIds;
+    QVector<quint32> strOffsets;
+    QByteArray pool;
+    nameIds.reserve(rows.size());
+    for (const Row& row : rows) {
+        const QString& name = games[row.source].name;
+        auto it = interned.constFind(name);
+        if (it == interned.constEnd()) {
+            quint32 sid = quint32(strOffsets.size());
+            strOffsets.append(quint32(pool.size()));
+            pool.append(name.toUtf8());
+            it = interned.insert(name, sid);
+        }
+        nameIds.append(it.value());
+    }
+    strOffsets.append(quint32(pool.size()));
+
+    quint32 count = quint32(rows.size());
+    QVector<quint32> hasFix((count + 31) / 32, 0);
+    for (quint32 i = 0; i < count; ++i) {
+        if (games[rows[int(i)].source].hasFix) hasFix[int(i / 32)] |= (1u << (i % 32));
+    }
+
+    QByteArray hashes;
+    hashes.reserve(int(count * HASH_SIZE));
+    for (const Row& row : rows) {
+        const QByteArray& digest = games[row.source].sha256;
+        hashes.append(digest.size() == HASH_SIZE ? digest : QByteArray(HASH_SIZE, '\0'));
+    }
+
+    QByteArray out;
+    out.reserve(int(HEADER_SIZE + count * 8 + strOffsets.size() * 4 + hasFix.size() * 4
+                    + hashes.size() + pool.size()));
+    out.append(MAGIC, 4);
+    appendU32(out, FORMAT_VERSION);
+    appendU32(out, count);
+    appendU32(out, quint32(strOffsets.size() - 1));
+    appendU32(out, quint32(pool.size()));
+    appendU32(out, 0); // reserved
+    uchar stamp[8];
+    qToLittleEndian<qint64>(generatedAt, stamp);
+    out.append(reinterpret_cast<const char*>(stamp), 8);
+    QByteArray digest = sourceDigest.left(DIGEST_SIZE);
+    digest.append(QByteArray(DIGEST_SIZE - digest.size(), '\0'));
+    out.append(digest);
+    appendU32(out, 0); // padding to HEADER_SIZE
+
+    for (const Row& row : rows) appendU32(out, row.appId);
+    for (quint32 sid : nameIds) appendU32(out, sid);
+    for (quint32 off : strOffsets) appendU32(out, off);
+    for (quint32 word : hasFix) appendU32(out, word);
+    out.append(hashes);
+    out.append(pool);
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    if (file.write(out) != out.size()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
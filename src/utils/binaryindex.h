@@ -0,0 +1,63 @@
+#ifndef BINARYINDEX_H
+#define BINARYINDEX_H
+
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QByteArray>
+#include "gameinfo.h"
+
+// Compact on-disk form of games_index.json, memory-mapped on startup.
+//
+// Layout (all integers little-endian quint32 unless noted):
+//   Header      magic "SLPI", version, count, stringCount, poolSize,
+//               generatedAt (qint64), sourceDigest (20 bytes SHA-1 of the JSON)
+//   appIds      [count]          sorted ascending
+//   nameIds     [count]          index into the string table
+//   strOffsets  [stringCount+1]  byte offsets into the pool (interned names)
+//   hasFix      [(count+31)/32]  bitset
+//   sha256      [count]          32-byte patch digests, all zero if unknown
+//   pool        [poolSize]       UTF-8 name bytes
+class BinaryIndex {
+public:
+    BinaryIndex() = default;
+    ~BinaryIndex();
+
+    bool open(const QString& path);
+    void close();
+    bool isValid() const { return m_data != nullptr; }
+
+    int count() const { return static_cast<int>(m_count); }
+    quint32 appIdAt(int i) const;
+    QString nameAt(int i) const;
+    bool hasFixAt(int i) const;
+    QByteArray sha256At(int i) const;
+    int indexOf(quint32 appId) const;
+
+    qint64 generatedAt() const { return m_generatedAt; }
+    QByteArray sourceDigest() const;
+
+    QList<GameInfo> toGameList() const;
+
+    static bool write(const QString& path, const QList<GameInfo>& games,
+                      qint64 generatedAt, const QByteArray& sourceDigest);
+
+private:
+    Q_DISABLE_COPY(BinaryIndex)
+
+    QFile m_file;
+    const uchar* m_data = nullptr;
+    qint64 m_size = 0;
+    quint32 m_count = 0;
+    quint32 m_stringCount = 0;
+    quint32 m_poolSize = 0;
+    qint64 m_generatedAt = 0;
+    const uchar* m_appIds = nullptr;
+    const uchar* m_nameIds = nullptr;
+    const uchar* m_strOffsets = nullptr;
+    const uchar* m_hasFix = nullptr;
+    const uchar* m_hashes = nullptr;
+    const char* m_pool = nullptr;
+};
+
+#endif // BINARYINDEX_H
@@ -0,0 +1,65 @@
+#include "gamecatalogue.h"
+#include "binaryindex.h"
+
+GameCatalogue::GameCatalogue(const QList<GameInfo>& games) {
+    m_ids.reserve(games.size());
+    m_names.reserve(games.size());
+    m_flags.reserve(games.size());
+    m_hashes.reserve(games.size());
+    m_rows.reserve(games.size());
+    for (const GameInfo& game : games) {
+        append(game.id, game.name, game.hasFix, game.sha256);
+    }
+}
+
+GameCatalogue::GameCatalogue(const QSharedPointer<const BinaryIndex>& index)
+    : m_index(index)
+{
+}
+
+int GameCatalogue::size() const {
+    return m_index ? m_index->count() : m_ids.size();
+}
+
+int GameCatalogue::indexOf(const QString& appId) const {
+    if (!m_index) return m_rows.value(appId, -1);
+    // Only the canonical spelling matches, as it would as a hash key
+    if (appId.isEmpty() || (appId.size() > 1 && appId.startsWith('0'))) return -1;
+    bool ok = false;
+    quint32 value = appId.toUInt(&ok);
+    return ok ? m_index->indexOf(value) : -1;
+}
+
+QString GameCatalogue::id(int row) const {
+    return m_index ? QString::number(m_index->appIdAt(row)) : m_ids.at(row);
+}
+
+QString GameCatalogue::name(int row) const {
+    return m_index ? m_index->nameAt(row) : m_names.at(row);
+}
+
+bool GameCatalogue::hasFix(int row) const {
+    return m_index ? m_index->hasFixAt(row) : (m_flags.at(row) & HasFix);
+}
+
+QByteArray GameCatalogue::sha256(int row) const {
+    return m_index ? m_index->sha256At(row) : m_hashes.at(row);
+}
+
+GameInfo GameCatalogue::at(int row) const {
+    GameInfo game;
+    game.id = id(row);
+    game.name = name(row);
+    game.hasFix = hasFix(row);
+    game.sha256 = sha256(row);
+    return game;
+}
+
+void GameCatalogue::append(const QString& id, const QString& name, bool hasFix, const QByteArray& sha256) {
+    if (m_rows.contains(id)) return;
+    m_rows.insert(id, m_ids.size());
+    m_ids.append(id);
+    m_names.append(name);
+    m_flags.append(hasFix ? HasFix : 0);
+    m_hashes.append(sha256);
+}
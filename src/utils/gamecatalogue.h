@@ -0,0 +1,56 @@
+#ifndef GAMECATALOGUE_H
+#define GAMECATALOGUE_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QList>
+#include <QMetaType>
+#include <QSharedPointer>
+#include "gameinfo.h"
+
+class BinaryIndex;
+
+// The supported-games list, row-addressable with constant-time appid lookups.
+// Built from a mapped BinaryIndex it keeps that mapping alive and reads rows
+// straight out of it: appids are found by binary search over the sorted id
+// column and names are only decoded when asked for. Built from parsed JSON it
+// holds the rows in column form with an appid -> row hash.
+// Copies are cheap and share the mapping, so it can cross threads by value.
+class GameCatalogue {
+public:
+    enum Flag : quint8 {
+        HasFix = 0x01
+    };
+
+    GameCatalogue() = default;
+    explicit GameCatalogue(const QList<GameInfo>& games);
+    explicit GameCatalogue(const QSharedPointer<const BinaryIndex>& index);
+
+    int size() const;
+    bool isEmpty() const { return size() == 0; }
+
+    int indexOf(const QString& appId) const;
+    bool contains(const QString& appId) const { return indexOf(appId) >= 0; }
+
+    QString id(int row) const;
+    QString name(int row) const;
+    bool hasFix(int row) const;
+    // Raw SHA-256 of the game's Lua patch as advertised by the index, or empty
+    QByteArray sha256(int row) const;
+    GameInfo at(int row) const;
+
+private:
+    void append(const QString& id, const QString& name, bool hasFix, const QByteArray& sha256);
+
+    QSharedPointer<const BinaryIndex> m_index; // when set, the columns below are unused
+    QVector<QString> m_ids;
+    QVector<QString> m_names;
+    QVector<quint8> m_flags;
+    QVector<QByteArray> m_hashes;
+    QHash<QString, int> m_rows;
+};
+
+Q_DECLARE_METATYPE(GameCatalogue)
+
+#endif // GAMECATALOGUE_H
@@ -2,12 +2,14 @@
 #define GAMEINFO_H
 
 #include <QString>
+#include <QByteArray>
 
 struct GameInfo {
     QString id;
     QString name;
     QString thumbnailUrl;
     bool hasFix = false;
+    QByteArray sha256; // raw digest of the Lua patch; empty when the index has none
     
     bool operator==(const GameInfo& other) const {
         return id == other.id;
@@ -0,0 +1,122 @@
+#include "librarymodel.h"
+#include "steamlocator.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+namespace {
+    // Copies and batch installs touch the folder many times in a row
+    const int RESCAN_DEBOUNCE_MS = 200;
+}
+
+LibraryModel::LibraryModel(QObject* parent)
+    : QObject(parent)
+    , m_watcher(new QFileSystemWatcher(this))
+    , m_rescanTimer(new QTimer(this))
+{
+    m_rescanTimer->setSingleShot(true);
+    m_rescanTimer->setInterval(RESCAN_DEBOUNCE_MS);
+    connect(m_rescanTimer, &QTimer::timeout, this, &LibraryModel::rescanPending);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, [this](const QString& dir) {
+        m_pendingDirs.insert(dir);
+        m_rescanTimer->start();
+    });
+
+    SteamLocator& locator = SteamLocator::instance();
+    connect(&locator, &SteamLocator::changed, this, [this]() {
+        setDirectories(SteamLocator::instance().pluginDirs());
+    });
+    // On a first run the folders arrive with the first changed()
+    if (locator.isReady()) setDirectories(locator.pluginDirs());
+}
+
+void LibraryModel::updateFile(const QString& appId) {
+    QStringList added;
+    QStringList removed;
+    for (const QString& dir : m_dirs.keys()) {
+        bool present = QFileInfo::exists(QDir(dir).filePath(appId + ".lua"));
+        setPresent(dir, appId, present, added, removed);
+    }
+    report(added, removed);
+}
+
+void LibraryModel::setDirectories(const QStringList& dirs) {
+    QStringList added;
+    QStringList removed;
+
+    QSet<QString> wanted(dirs.begin(), dirs.end());
+    for (const QString& dir : m_dirs.keys()) {
+        if (wanted.contains(dir)) continue;
+        applyListing(dir, QSet<QString>(), added, removed);
+        m_dirs.remove(dir);
+        m_pendingDirs.remove(dir);
+        m_watcher->removePath(dir);
+    }
+    for (const QString& dir : dirs) {
+        if (m_dirs.contains(dir)) continue;
+        m_dirs.insert(dir, QSet<QString>());
+        m_watcher->addPath(dir);
+        applyListing(dir, list(dir), added, removed);
+    }
+    report(added, removed);
+}
+
+void LibraryModel::rescanPending() {
+    QStringList added;
+    QStringList removed;
+    for (const QString& dir : m_pendingDirs) {
+        if (!m_dirs.contains(dir)) continue;
+        // A folder that was deleted and recreated loses its watch
+        if (!m_watcher->directories().contains(dir)) m_watcher->addPath(dir);
+        applyListing(dir, list(dir), added, removed);
+    }
+    m_pendingDirs.clear();
+    report(added, removed);
+}
+
+void LibraryModel::applyListing(const QString& dir, const QSet<QString>& ids,
+                                QStringList& added, QStringList& removed) {
+    const QSet<QString> known = m_dirs.value(dir);
+    for (const QString& appId : known) {
+        if (!ids.contains(appId)) setPresent(dir, appId, false, added, removed);
+    }
+    for (const QString& appId : ids) {
+        if (!known.contains(appId)) setPresent(dir, appId, true, added, removed);
+    }
+}
+
+void LibraryModel::setPresent(const QString& dir, const QString& appId, bool present,
+                              QStringList& added, QStringList& removed) {
+    QSet<QString>& ids = m_dirs[dir];
+    if (ids.contains(appId) == present) return;
+
+    if (present) {
+        ids.insert(appId);
+        if (m_refs[appId]++ == 0) {
+            m_order.append(appId);
+            if (!removed.removeOne(appId)) added.append(appId);
+        }
+    } else {
+        ids.remove(appId);
+        if (--m_refs[appId] == 0) {
+            m_refs.remove(appId);
+            m_order.removeOne(appId);
+            if (!added.removeOne(appId)) removed.append(appId);
+        }
+    }
+}
+
+void LibraryModel::report(const QStringList& addedIds, const QStringList& removedIds) {
+    if (!removedIds.isEmpty()) emit removed(removedIds);
+    if (!addedIds.isEmpty()) emit added(addedIds);
+}
+
+QSet<QString> LibraryModel::list(const QString& dir) {
+    QSet<QString> ids;
+    for (const QString& file : QDir(dir).entryList({"*.lua"}, QDir::Files)) {
+        QString appId = QFileInfo(file).baseName();
+        if (!appId.isEmpty()) ids.insert(appId);
+    }
+    return ids;
+}
@@ -0,0 +1,57 @@
+#ifndef LIBRARYMODEL_H
+#define LIBRARYMODEL_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+class QFileSystemWatcher;
+class QTimer;
+
+// Installed patches across every stplug-in folder SteamLocator knows about.
+// The folders are listed once and then watched; when one changes only that
+// folder is listed again and the difference is reported through added() and
+// removed(), so the Library view can be updated in place. A game counts as
+// installed while any folder holds its <appid>.lua.
+// Lives on the GUI thread.
+class LibraryModel : public QObject {
+    Q_OBJECT
+
+public:
+    explicit LibraryModel(QObject* parent = nullptr);
+
+    // In the order they were first seen
+    const QStringList& appIds() const { return m_order; }
+    bool contains(const QString& appId) const { return m_refs.contains(appId); }
+    int count() const { return m_order.size(); }
+
+    // Re-checks one game in every folder after the app wrote or deleted its
+    // file, without waiting for the watcher
+    void updateFile(const QString& appId);
+
+signals:
+    void added(const QStringList& appIds);
+    void removed(const QStringList& appIds);
+
+private:
+    void setDirectories(const QStringList& dirs);
+    void rescanPending();
+    void applyListing(const QString& dir, const QSet<QString>& ids,
+                      QStringList& added, QStringList& removed);
+    void setPresent(const QString& dir, const QString& appId, bool present,
+                    QStringList& added, QStringList& removed);
+    void report(const QStringList& addedIds, const QStringList& removedIds);
+
+    static QSet<QString> list(const QString& dir);
+
+    QFileSystemWatcher* m_watcher;
+    QTimer* m_rescanTimer;
+    QSet<QString> m_pendingDirs;
+    QHash<QString, QSet<QString>> m_dirs; // folder -> app ids with a file there
+    QHash<QString, int> m_refs;           // app id -> folders holding it
+    QStringList m_order;
+};
+
+#endif // LIBRARYMODEL_H
@@ -0,0 +1,123 @@
+#include "namecache.h"
+#include "paths.h"
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTimer>
+
+namespace {
+    const qint64 FOUND_TTL_SECS = 30 * 24 * 3600;
+    const qint64 MISSING_TTL_SECS = 24 * 3600;
+    // Name fetches finish in bursts; one write per burst is enough
+    const int SAVE_DELAY_MS = 5000;
+
+    bool isFresh(const QString& name, qint64 fetchedAt, qint64 now) {
+        return now - fetchedAt < (name.isEmpty() ? MISSING_TTL_SECS : FOUND_TTL_SECS);
+    }
+}
+
+NameCache::NameCache(QObject* parent)
+    : QObject(parent)
+    , m_path(Paths::getLocalNameCachePath())
+    , m_saveTimer(new QTimer(this))
+{
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(SAVE_DELAY_MS);
+    connect(m_saveTimer, &QTimer::timeout, this, &NameCache::save);
+
+    m_pool.setMaxThreadCount(1);
+    QString path = m_path;
+    m_pool.start([this, path]() {
+        Entries entries = read(path);
+        QMetaObject::invokeMethod(this, [this, entries]() { onLoaded(entries); }, Qt::QueuedConnection);
+    });
+}
+
+NameCache::~NameCache() {
+    m_pool.waitForDone();
+    if (!m_dirty) return;
+    // Quitting before the startup read was merged: merge it here so it isn't overwritten
+    if (!m_loaded) {
+        Entries disk = read(m_path);
+        for (auto it = disk.constBegin(); it != disk.constEnd(); ++it) {
+            if (!m_entries.contains(it.key())) m_entries.insert(it.key(), it.value());
+        }
+    }
+    write(m_path, m_entries);
+}
+
+bool NameCache::lookup(const QString& appId, QString& name) const {
+    auto it = m_entries.constFind(appId);
+    if (it == m_entries.constEnd()) return false;
+    if (!isFresh(it->name, it->fetchedAt, QDateTime::currentSecsSinceEpoch())) return false;
+    name = it->name;
+    return true;
+}
+
+void NameCache::insert(const QString& appId, const QString& name) {
+    Entry entry;
+    entry.name = name;
+    entry.fetchedAt = QDateTime::currentSecsSinceEpoch();
+    m_entries.insert(appId, entry);
+    m_dirty = true;
+    m_saveTimer->start();
+}
+
+void NameCache::onLoaded(const Entries& entries) {
+    // Anything fetched while the file was being read is newer
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        if (!m_entries.contains(it.key())) m_entries.insert(it.key(), it.value());
+    }
+    m_loaded = true;
+    emit loaded();
+}
+
+void NameCache::save() {
+    if (!m_dirty) return;
+    if (!m_loaded) {
+        // Writing now would drop everything still on its way in from disk
+        m_saveTimer->start();
+        return;
+    }
+    m_dirty = false;
+    QString path = m_path;
+    Entries entries = m_entries;
+    m_pool.start([path, entries]() { write(path, entries); });
+}
+
+NameCache::Entries NameCache::read(const QString& path) {
+    Entries entries;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return entries;
+    QJsonObject obj = QJsonDocument::fromJson(file.readAll()).object();
+
+    qint64 now = QDateTime::currentSecsSinceEpoch();
+    entries.reserve(obj.size());
+    for (auto it = obj.constBegin(); it != obj.constEnd(); ++it) {
+        QJsonObject item = it.value().toObject();
+        Entry entry;
+        entry.name = item.value("name").toString();
+        entry.fetchedAt = item.value("fetched_at").toInteger();
+        if (isFresh(entry.name, entry.fetchedAt, now)) entries.insert(it.key(), entry);
+    }
+    return entries;
+}
+
+void NameCache::write(const QString& path, const Entries& entries) {
+    qint64 now = QDateTime::currentSecsSinceEpoch();
+    QJsonObject obj;
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        if (!isFresh(it->name, it->fetchedAt, now)) continue;
+        QJsonObject item;
+        item["name"] = it->name;
+        item["fetched_at"] = it->fetchedAt;
+        obj[it.key()] = item;
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return;
+    file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    file.commit();
+}
@@ -0,0 +1,58 @@
+#ifndef NAMECACHE_H
+#define NAMECACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QThreadPool>
+
+class QTimer;
+
+// App id -> store name, remembered across sessions so games the index has no
+// name for are looked up once rather than on every launch and tab switch.
+// Ids the store and SteamSpy both came back empty for are remembered too,
+// for a shorter time, since a store page can still appear later.
+// The file is read on a worker thread at startup and written back there a
+// few seconds after the last change; lookups before it has loaded miss.
+// Lives on the GUI thread.
+class NameCache : public QObject {
+    Q_OBJECT
+
+public:
+    explicit NameCache(QObject* parent = nullptr);
+    ~NameCache();
+
+    // True when there is a fresh answer; name is empty for a known miss
+    bool lookup(const QString& appId, QString& name) const;
+    // An empty name records that nothing could be found
+    void insert(const QString& appId, const QString& name);
+
+    bool isLoaded() const { return m_loaded; }
+
+signals:
+    // The disk copy has been merged in
+    void loaded();
+
+private:
+    struct Entry {
+        QString name;
+        qint64 fetchedAt = 0; // seconds since the epoch
+    };
+    using Entries = QHash<QString, Entry>;
+
+    void onLoaded(const Entries& entries);
+    void scheduleSave();
+    void save();
+
+    static Entries read(const QString& path);
+    static void write(const QString& path, const Entries& entries);
+
+    QString m_path;
+    Entries m_entries;
+    bool m_loaded = false;
+    bool m_dirty = false;
+    QTimer* m_saveTimer;
+    QThreadPool m_pool; // one thread, so writes land in order
+};
+
+#endif // NAMECACHE_H
@@ -0,0 +1,191 @@
+#include "nameresolver.h"
+#include "namecache.h"
+#include "networkclient.h"
+#include "../config.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QUrlQuery>
+
+namespace {
+    // App ids per /api/names request; the server accepts up to 200
+    const int MAX_BATCH = 200;
+    // Backoff between retries of a batch the server failed, doubling up to the cap
+    const int FIRST_RETRY_DELAY_MS = 2000;
+    const int MAX_RETRY_DELAY_MS = 60000;
+}
+
+NameResolver::NameResolver(RequestScheduler* scheduler, NameCache* cache, QObject* parent)
+    : QObject(parent)
+    , m_scheduler(scheduler)
+    , m_cache(cache)
+{
+    m_retryTimer.setSingleShot(true);
+    connect(&m_retryTimer, &QTimer::timeout, this, &NameResolver::retryWaiting);
+
+    // Ids requested before the disk copy was read may have an answer there:
+    // pull back whatever hasn't been sent and ask again
+    connect(m_cache, &NameCache::loaded, this, [this]() {
+        QHash<int, QStringList> unsent;
+        for (RequestScheduler::Ticket ticket : m_tickets.keys()) {
+            if (m_scheduler->isStarted(ticket)) continue;
+            unsent[m_scheduler->priorityOf(ticket)] += m_tickets.value(ticket);
+            drop(ticket);
+        }
+        for (auto it = unsent.constBegin(); it != unsent.constEnd(); ++it) {
+            request(it.value(), RequestScheduler::Priority(it.key()));
+        }
+    });
+}
+
+void NameResolver::request(const QStringList& appIds, RequestScheduler::Priority priority) {
+    QStringList missing;
+    for (const QString& appId : appIds) {
+        auto waiting = m_waiting.constFind(appId);
+        if (waiting != m_waiting.constEnd()) {
+            if (priority < m_scheduler->priorityOf(*waiting)) m_scheduler->setPriority(*waiting, priority);
+            continue;
+        }
+        auto retrying = m_retrying.find(appId);
+        if (retrying != m_retrying.end()) {
+            if (priority < *retrying) *retrying = priority;
+            continue;
+        }
+        QString name;
+        if (m_cache->lookup(appId, name)) {
+            emit resolved(appId, name);
+            continue;
+        }
+        missing.append(appId);
+    }
+
+    if (m_batchAvailable) {
+        for (int i = 0; i < missing.size(); i += MAX_BATCH) sendBatch(missing.mid(i, MAX_BATCH), priority);
+    } else {
+        for (const QString& appId : missing) sendStore(appId, "steam_store", priority);
+    }
+}
+
+void NameResolver::clearQueue() {
+    for (RequestScheduler::Ticket ticket : m_tickets.keys()) {
+        if (!m_scheduler->isStarted(ticket)) drop(ticket);
+    }
+    m_retrying.clear();
+}
+
+void NameResolver::retryWaiting() {
+    QHash<int, QStringList> byPriority;
+    for (auto it = m_retrying.constBegin(); it != m_retrying.constEnd(); ++it) {
+        byPriority[it.value()].append(it.key());
+    }
+    m_retrying.clear();
+    for (auto it = byPriority.constBegin(); it != byPriority.constEnd(); ++it) {
+        request(it.value(), RequestScheduler::Priority(it.key()));
+    }
+}
+
+void NameResolver::drop(RequestScheduler::Ticket ticket) {
+    QStringList appIds = m_tickets.take(ticket);
+    for (const QString& appId : appIds) m_waiting.remove(appId);
+    // The handler sees nullptr and finds nothing left to do
+    m_scheduler->cancel(ticket);
+}
+
+void NameResolver::sendBatch(const QStringList& appIds, RequestScheduler::Priority priority) {
+    QUrl url(Config::namesApiUrl());
+    QUrlQuery query;
+    query.addQueryItem("ids", appIds.join(','));
+    url.setQuery(query);
+    QNetworkRequest request(url);
+    NetworkClient::prepare(request);
+
+    RequestScheduler::Ticket ticket = m_scheduler->enqueue(request, priority, this,
+            [this, appIds, priority](QNetworkReply* reply) { onBatchFinished(reply, appIds, priority); });
+    m_tickets.insert(ticket, appIds);
+    for (const QString& appId : appIds) m_waiting.insert(appId, ticket);
+}
+
+void NameResolver::sendStore(const QString& appId, const QString& source, RequestScheduler::Priority priority) {
+    QUrl url = source == "steamspy"
+        ? QUrl(QString("https://steamspy.com/api.php?request=appdetails&appid=%1").arg(appId))
+        : QUrl(QString("https://store.steampowered.com/api/appdetails?appids=%1").arg(appId));
+    QNetworkRequest request(url);
+    NetworkClient::prepare(request);
+
+    RequestScheduler::Ticket ticket = m_scheduler->enqueue(request, priority, this,
+            [this, appId, source, priority](QNetworkReply* reply) { onStoreFinished(reply, appId, source, priority); });
+    m_tickets.insert(ticket, {appId});
+    m_waiting.insert(appId, ticket);
+}
+
+void NameResolver::onBatchFinished(QNetworkReply* reply, const QStringList& appIds, RequestScheduler::Priority priority) {
+    if (!reply) return; // dropped before it started
+    m_tickets.remove(m_waiting.value(appIds.first()));
+    for (const QString& appId : appIds) m_waiting.remove(appId);
+
+    if (reply->error() != QNetworkReply::NoError) {
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (status == 404 || status == 405) {
+            // An older server without the endpoint: ask the store one id at a time instead
+            m_batchAvailable = false;
+            for (const QString& appId : appIds) sendStore(appId, "steam_store", priority);
+            return;
+        }
+        // An outage or an overloaded server: send the same ids again after a backoff
+        retryLater(appIds, priority);
+        return;
+    }
+
+    QJsonObject names = QJsonDocument::fromJson(reply->readAll()).object().value("names").toObject();
+    QStringList leftOut;
+    for (const QString& appId : appIds) {
+        if (names.contains(appId)) finish(appId, names.value(appId).toString(), true);
+        else leftOut.append(appId);
+    }
+    // Left out: the server ran out of time or couldn't reach the store
+    if (leftOut.isEmpty()) m_retryDelayMs = 0;
+    else retryLater(leftOut, priority);
+}
+
+void NameResolver::retryLater(const QStringList& appIds, RequestScheduler::Priority priority) {
+    for (const QString& appId : appIds) {
+        auto it = m_retrying.find(appId);
+        if (it == m_retrying.end()) m_retrying.insert(appId, priority);
+        else if (priority < *it) *it = priority;
+    }
+    m_retryDelayMs = m_retryDelayMs == 0 ? FIRST_RETRY_DELAY_MS : qMin(m_retryDelayMs * 2, MAX_RETRY_DELAY_MS);
+    if (!m_retryTimer.isActive()) m_retryTimer.start(m_retryDelayMs);
+}
+
+void NameResolver::onStoreFinished(QNetworkReply* reply, const QString& appId, const QString& source,
+                                   RequestScheduler::Priority priority) {
+    if (!reply) return;
+    m_tickets.remove(m_waiting.take(appId));
+
+    QString name;
+    bool answered = reply->error() == QNetworkReply::NoError;
+    if (answered) {
+        QJsonObject obj = QJsonDocument::fromJson(reply->readAll()).object();
+        if (source == "steam_store") {
+            QJsonObject root = obj.value(appId).toObject();
+            if (root["success"].toBool() && root.contains("data"))
+                name = root["data"].toObject()["name"].toString();
+        } else {
+            name = obj.value("name").toString();
+        }
+    }
+
+    if (name.isEmpty() && source == "steam_store") {
+        // Stays waiting, so requests for this id keep joining it
+        sendStore(appId, "steamspy", priority);
+        return;
+    }
+    finish(appId, name, answered);
+}
+
+void NameResolver::finish(const QString& appId, const QString& name, bool answered) {
+    // Only a real answer is remembered, including "no name"; network errors are retried next time
+    if (answered) m_cache->insert(appId, name);
+    emit resolved(appId, name);
+}
@@ -0,0 +1,64 @@
+#ifndef NAMERESOLVER_H
+#define NAMERESOLVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include "requestscheduler.h"
+
+class QNetworkReply;
+class NameCache;
+
+// Looks up store names for app ids, one request per id at most however many
+// views ask for it. An id that is already waiting or in flight is joined rather
+// than requested again, and every answer is broadcast through resolved(), so
+// whichever card shows that id picks it up. Views that stop caring just ignore
+// the signal: requests already sent run to completion and land in the cache.
+// Ids go to our /api/names endpoint in batches. A server without that
+// endpoint (404/405) makes the session fall back to the Steam store (then
+// SteamSpy) one id at a time; any other failure sends the batch again after a
+// growing backoff, as do ids the server left out of its answer.
+class NameResolver : public QObject {
+    Q_OBJECT
+
+public:
+    NameResolver(RequestScheduler* scheduler, NameCache* cache, QObject* parent = nullptr);
+
+    // Cached answers are emitted before this returns; the rest are scheduled
+    // at the given priority (ids already waiting at a lower one move up)
+    void request(const QStringList& appIds, RequestScheduler::Priority priority = RequestScheduler::Visible);
+    // Drops requests the scheduler hasn't started yet; those in flight are kept
+    void clearQueue();
+
+    bool isInFlight(const QString& appId) const { return m_waiting.contains(appId) || m_retrying.contains(appId); }
+
+signals:
+    // name is empty when the id couldn't be resolved (this time or at all)
+    void resolved(const QString& appId, const QString& name);
+
+private:
+    void sendBatch(const QStringList& appIds, RequestScheduler::Priority priority);
+    void sendStore(const QString& appId, const QString& source, RequestScheduler::Priority priority);
+    void onBatchFinished(QNetworkReply* reply, const QStringList& appIds, RequestScheduler::Priority priority);
+    void onStoreFinished(QNetworkReply* reply, const QString& appId, const QString& source,
+                         RequestScheduler::Priority priority);
+    void finish(const QString& appId, const QString& name, bool answered);
+    void drop(RequestScheduler::Ticket ticket);
+    // Keeps the ids waiting and sends them again after a growing backoff
+    void retryLater(const QStringList& appIds, RequestScheduler::Priority priority);
+    void retryWaiting();
+
+    RequestScheduler* m_scheduler;
+    NameCache* m_cache;
+    QHash<QString, RequestScheduler::Ticket> m_waiting;   // app id -> request carrying it
+    QHash<RequestScheduler::Ticket, QStringList> m_tickets;
+    bool m_batchAvailable = true;
+    QHash<QString, RequestScheduler::Priority> m_retrying; // app id -> priority, waiting out the backoff
+    QTimer m_retryTimer;
+    int m_retryDelayMs = 0;
+};
+
+#endif // NAMERESOLVER_H
@@ -0,0 +1,463 @@
+#include "networkclient.h"
+#include "../config.h"
+#include <QCoreApplication>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QQueue>
+#include <QTimer>
+#include <QUrl>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    QString partialMetaPath(const QString& path) {
+        return path + ".part.json";
+    }
+
+    bool syncToDisk(QFile& file) {
+        if (!file.flush()) return false;
+#ifdef Q_OS_WIN
+        return _commit(file.handle()) == 0;
+#else
+        return ::fsync(file.handle()) == 0;
+#endif
+    }
+}
+
+NetworkClient& NetworkClient::instance() {
+    // Deliberately never destroyed; the thread is stopped when the application quits
+    static NetworkClient* client = new NetworkClient();
+    return *client;
+}
+
+NetworkClient::NetworkClient() {
+    m_thread.setObjectName("NetworkClient");
+    m_thread.start();
+    moveToThread(&m_thread);
+
+    QMetaObject::invokeMethod(this, [this]() {
+        m_manager = new QNetworkAccessManager();
+        m_manager->setAutoDeleteReplies(false);
+    }, Qt::BlockingQueuedConnection);
+
+    connect(&m_thread, &QThread::finished, m_manager, &QObject::deleteLater);
+    if (QCoreApplication* app = QCoreApplication::instance()) {
+        connect(app, &QCoreApplication::aboutToQuit, app, [this]() { shutdown(); }, Qt::DirectConnection);
+    }
+}
+
+void NetworkClient::prepare(QNetworkRequest& request) {
+    if (!request.hasRawHeader("User-Agent")) {
+        request.setHeader(QNetworkRequest::UserAgentHeader, "SteamLuaPatcher/2.0");
+    }
+    // The token is only meant for our server, not third-party hosts
+    if (request.url().host() == QUrl(Config::WEBSERVER_BASE_URL).host()
+        && !request.hasRawHeader("X-Access-Token")) {
+        request.setRawHeader("X-Access-Token", Config::getAccessToken().toUtf8());
+    }
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+}
+
+QNetworkReply* NetworkClient::get(QNetworkRequest request) {
+    return get(request, nullptr, nullptr);
+}
+
+QNetworkReply* NetworkClient::get(QNetworkRequest request, QObject* context,
+                                  const std::function<void(QNetworkReply*)>& onFinished) {
+    prepare(request);
+
+    QNetworkReply* reply = nullptr;
+    auto start = [this, &reply, &request, context, &onFinished]() {
+        reply = m_manager->get(request);
+        if (context && onFinished) {
+            QNetworkReply* r = reply;
+            std::function<void(QNetworkReply*)> callback = onFinished;
+            connect(r, &QNetworkReply::finished, context, [r, callback]() { callback(r); });
+        }
+    };
+
+    if (QThread::currentThread() == &m_thread) start();
+    else QMetaObject::invokeMethod(this, start, Qt::BlockingQueuedConnection);
+    return reply;
+}
+
+NetworkClient::DownloadResult NetworkClient::download(QNetworkRequest request, const QString& path, int timeoutMs,
+                                                      const std::function<void(qint64, qint64)>& onProgress) {
+    const qint64 chunkSize = 256 * 1024;
+    DownloadResult result;
+    prepare(request);
+
+    // Resume an earlier attempt only if the partial file still matches its sidecar
+    // and there is a validator to make sure the server still has the same file
+    const QString partPath = path + ".part";
+    PartialDownload state = readPartial(path);
+    qint64 offset = 0;
+    if (state.url == request.url().toString() && state.offset > 0
+        && state.offset == QFileInfo(partPath).size() && !state.validator().isEmpty()) {
+        offset = state.offset;
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(offset) + "-");
+        // The server answers 200 with the whole file instead if it changed since
+        request.setRawHeader("If-Range", state.validator());
+    } else {
+        state = PartialDownload();
+        state.url = request.url().toString();
+    }
+    result.resumedFrom = offset;
+
+    QFile file(partPath);
+    if (!file.open(QIODevice::ReadWrite) || !file.resize(offset) || !file.seek(offset)) {
+        result.error = QString("Failed to open %1: %2").arg(partPath, file.errorString());
+        return result;
+    }
+
+    // Chunks are written on the network thread as soon as they arrive, so the
+    // reply never holds more than one read buffer's worth of data.
+    // Only that thread touches the file until the reply has finished.
+    bool started = false;
+    bool discard = false;
+    qint64 expectedSize = -1;
+    QString writeError;
+    auto drain = [&](QNetworkReply* reply) {
+        if (!started) {
+            started = true;
+            int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            qint64 rangeStart = -1;
+            if (status == 206) {
+                // Content-Range: bytes <start>-<end>/<size or *>
+                QByteArray range = reply->rawHeader("Content-Range");
+                int space = range.indexOf(' ');
+                int dash = range.indexOf('-');
+                int slash = range.indexOf('/');
+                if (space >= 0 && dash > space && slash > dash) {
+                    rangeStart = range.mid(space + 1, dash - space - 1).toLongLong();
+                    bool ok = false;
+                    qint64 size = range.mid(slash + 1).toLongLong(&ok);
+                    if (ok) expectedSize = size;
+                }
+            }
+            if (status == 206 && rangeStart == offset) {
+                // Appending to the partial file
+            } else if (status == 200) {
+                if (offset > 0) {
+                    offset = 0;
+                    file.resize(0);
+                    file.seek(0);
+                }
+                QVariant length = reply->header(QNetworkRequest::ContentLengthHeader);
+                if (length.isValid()) expectedSize = length.toLongLong();
+            } else {
+                discard = true;
+            }
+            // Transparently decompressed bodies don't match the advertised length
+            if (reply->hasRawHeader("Content-Encoding")) expectedSize = -1;
+
+            QByteArray etag = reply->rawHeader("ETag");
+            state.etag = etag.startsWith("W/") ? QByteArray() : etag; // If-Range needs a strong ETag
+            state.lastModified = reply->rawHeader("Last-Modified");
+        }
+        while (writeError.isEmpty() && reply->bytesAvailable() > 0) {
+            QByteArray chunk = reply->read(chunkSize);
+            if (discard) continue;
+            if (file.write(chunk) != chunk.size()) {
+                writeError = file.errorString();
+                reply->abort();
+            }
+        }
+    };
+
+    QNetworkReply* reply = nullptr;
+    auto start = [this, &reply, &request, &drain, &onProgress, &offset, chunkSize]() {
+        reply = m_manager->get(request);
+        reply->setReadBufferSize(chunkSize);
+        QNetworkReply* r = reply;
+        connect(r, &QNetworkReply::readyRead, r, [r, &drain]() { drain(r); });
+        if (onProgress) {
+            std::function<void(qint64, qint64)> callback = onProgress;
+            connect(r, &QNetworkReply::downloadProgress, r, [callback, &offset](qint64 received, qint64 total) {
+                callback(offset + received, total > 0 ? offset + total : total);
+            });
+        }
+    };
+    if (QThread::currentThread() == &m_thread) start();
+    else QMetaObject::invokeMethod(this, start, Qt::BlockingQueuedConnection);
+
+    bool finished = waitForFinished(reply, timeoutMs);
+    if (finished) drain(reply); // anything left after the last readyRead
+    result.httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (!finished) {
+        result.timedOut = true;
+        result.error = "Connection timed out";
+    } else if (!writeError.isEmpty()) {
+        result.error = QString("Failed to write %1: %2").arg(partPath, writeError);
+    } else if (reply->error() != QNetworkReply::NoError) {
+        result.error = reply->errorString();
+    } else if (discard) {
+        result.error = QString("Unexpected HTTP status %1").arg(result.httpStatus);
+    }
+    reply->deleteLater();
+
+    file.flush();
+    result.bytes = file.size();
+    if (result.error.isEmpty() && expectedSize >= 0 && result.bytes != expectedSize) {
+        result.error = QString("Incomplete download: got %1 of %2 bytes").arg(result.bytes).arg(expectedSize);
+        discard = true; // the partial file can't be trusted
+    }
+
+    settlePartial(file, path, state, result, writeError.isEmpty() && !discard);
+    return result;
+}
+
+NetworkClient::DownloadResult NetworkClient::stream(QNetworkRequest request, int timeoutMs,
+                                                    const std::function<bool(const QByteArray&)>& onData,
+                                                    const std::function<void(qint64, qint64)>& onProgress,
+                                                    const QString& path) {
+    const qint64 chunkSize = 256 * 1024;
+    const qint64 maxQueued = 8 * chunkSize;
+    DownloadResult result;
+    prepare(request);
+
+    // A stream always starts from byte 0, so an older partial file is replaced
+    const QString partPath = path + ".part";
+    QFile file(partPath);
+    PartialDownload state;
+    state.url = request.url().toString();
+    if (!path.isEmpty()) {
+        QFile::remove(partialMetaPath(path));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            result.error = QString("Failed to open %1: %2").arg(partPath, file.errorString());
+            return result;
+        }
+    }
+    bool consumerDone = false;  // onData gave up; the file still receives the rest
+    qint64 expectedSize = -1;
+    QString writeError;
+
+    // Filled on the network thread, emptied on this one
+    QMutex mutex;
+    QQueue<QByteArray> chunks;
+    qint64 queued = 0;
+    bool stalled = false;
+    bool discard = false;
+    bool started = false;
+
+    QObject context; // lives on this thread, receives the "data ready" calls
+    QNetworkReply* reply = nullptr;
+    bool aborted = false;
+    std::function<void(QNetworkReply*)> fill;
+
+    auto consume = [&]() {
+        QQueue<QByteArray> ready;
+        bool resume = false;
+        {
+            QMutexLocker lock(&mutex);
+            ready.swap(chunks);
+            queued = 0;
+            resume = stalled;
+            stalled = false;
+        }
+        for (const QByteArray& chunk : ready) {
+            if (aborted) break;
+            if (file.isOpen() && file.write(chunk) != chunk.size()) {
+                writeError = file.errorString();
+                aborted = true;
+                abort(reply);
+                break;
+            }
+            result.bytes += chunk.size();
+            if (consumerDone) continue;
+            if (!onData(chunk)) {
+                consumerDone = true;
+                // Without a file there is nothing left to receive the body for
+                if (!file.isOpen()) {
+                    aborted = true;
+                    abort(reply);
+                }
+            }
+        }
+        if (resume && !aborted) {
+            QNetworkReply* r = reply;
+            QMetaObject::invokeMethod(r, [r, &fill]() { fill(r); }, Qt::QueuedConnection);
+        }
+    };
+
+    fill = [&](QNetworkReply* r) {
+        bool added = false;
+        {
+            QMutexLocker lock(&mutex);
+            if (!started) {
+                started = true;
+                discard = r->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200;
+                QVariant length = r->header(QNetworkRequest::ContentLengthHeader);
+                // Transparently decompressed bodies don't match the advertised length
+                if (length.isValid() && !r->hasRawHeader("Content-Encoding")) expectedSize = length.toLongLong();
+                QByteArray etag = r->rawHeader("ETag");
+                state.etag = etag.startsWith("W/") ? QByteArray() : etag; // If-Range needs a strong ETag
+                state.lastModified = r->rawHeader("Last-Modified");
+            }
+            while (queued < maxQueued && r->bytesAvailable() > 0) {
+                QByteArray chunk = r->read(chunkSize);
+                if (discard) continue;
+                queued += chunk.size();
+                chunks.enqueue(chunk);
+                added = true;
+            }
+            stalled = r->bytesAvailable() > 0;
+        }
+        if (added) QMetaObject::invokeMethod(&context, consume, Qt::QueuedConnection);
+    };
+
+    auto start = [this, &reply, &request, &fill, &onProgress, chunkSize]() {
+        reply = m_manager->get(request);
+        reply->setReadBufferSize(chunkSize);
+        QNetworkReply* r = reply;
+        connect(r, &QNetworkReply::readyRead, r, [r, &fill]() { fill(r); });
+        if (onProgress) connect(r, &QNetworkReply::downloadProgress, r, onProgress);
+    };
+    if (QThread::currentThread() == &m_thread) start();
+    else QMetaObject::invokeMethod(this, start, Qt::BlockingQueuedConnection);
+
+    // Queued consume calls run inside this wait
+    bool finished = waitForFinished(reply, timeoutMs);
+
+    // Drain what is still buffered. Running this on the network thread also
+    // flushes any fill() still queued there, so none can run after we return.
+    bool more = true;
+    while (more) {
+        bool drain = finished && !aborted;
+        QMetaObject::invokeMethod(reply, [&]() {
+            if (drain) fill(reply);
+            more = drain && reply->bytesAvailable() > 0;
+        }, Qt::BlockingQueuedConnection);
+        if (drain) consume();
+    }
+
+    result.httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (!writeError.isEmpty()) {
+        result.error = QString("Failed to write %1: %2").arg(partPath, writeError);
+    } else if (aborted) {
+        result.error = "Download aborted";
+    } else if (!finished) {
+        result.timedOut = true;
+        result.error = "Connection timed out";
+    } else if (reply->error() != QNetworkReply::NoError) {
+        result.error = reply->errorString();
+    } else if (discard) {
+        result.error = QString("Unexpected HTTP status %1").arg(result.httpStatus);
+    } else if (expectedSize >= 0 && result.bytes != expectedSize) {
+        result.error = QString("Incomplete download: got %1 of %2 bytes").arg(result.bytes).arg(expectedSize);
+        discard = true; // the partial file can't be trusted
+    }
+    reply->deleteLater();
+
+    if (path.isEmpty()) {
+        result.ok = result.error.isEmpty();
+        return result;
+    }
+    settlePartial(file, path, state, result, writeError.isEmpty() && !discard);
+    return result;
+}
+
+void NetworkClient::settlePartial(QFile& file, const QString& path, PartialDownload& state,
+                                  DownloadResult& result, bool resumable) {
+    const QString partPath = path + ".part";
+    if (!result.error.isEmpty()) {
+        // Keep what arrived for the next attempt if it can be resumed safely
+        file.close();
+        state.offset = result.bytes;
+        if (resumable && state.offset > 0 && !state.validator().isEmpty()) {
+            writePartial(path, state);
+        } else {
+            QFile::remove(partPath);
+            QFile::remove(partialMetaPath(path));
+        }
+        return;
+    }
+
+    // Flushed to disk before it replaces path, so a crash can't leave a truncated file behind
+    if (!syncToDisk(file)) {
+        result.error = QString("Failed to sync %1").arg(partPath);
+        return;
+    }
+    file.close();
+    QFile::remove(path);
+    if (!QFile::rename(partPath, path)) {
+        result.error = QString("Failed to move %1 into place").arg(partPath);
+        return;
+    }
+    QFile::remove(partialMetaPath(path));
+    result.ok = true;
+}
+
+NetworkClient::PartialDownload NetworkClient::readPartial(const QString& path) {
+    PartialDownload state;
+    QFile file(partialMetaPath(path));
+    if (!file.open(QIODevice::ReadOnly)) return state;
+    QJsonObject obj = QJsonDocument::fromJson(file.readAll()).object();
+    state.url = obj["url"].toString();
+    state.etag = obj["etag"].toString().toLatin1();
+    state.lastModified = obj["last_modified"].toString().toLatin1();
+    state.offset = static_cast<qint64>(obj["offset"].toDouble(0));
+    return state;
+}
+
+void NetworkClient::writePartial(const QString& path, const PartialDownload& state) {
+    QJsonObject obj;
+    obj["url"] = state.url;
+    obj["etag"] = QString::fromLatin1(state.etag);
+    obj["last_modified"] = QString::fromLatin1(state.lastModified);
+    obj["offset"] = static_cast<double>(state.offset);
+
+    QSaveFile file(partialMetaPath(path));
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+        file.commit();
+    }
+}
+
+bool NetworkClient::waitForFinished(QNetworkReply* reply, int timeoutMs) {
+    QEventLoop loop;
+    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+
+    QTimer timer;
+    timer.setSingleShot(true);
+    connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+    timer.start(timeoutMs);
+
+    // The reply may have completed on the network thread before we connected
+    if (!reply->isFinished()) loop.exec();
+
+    if (reply->isFinished()) return true;
+    abort(reply);
+    return false;
+}
+
+void NetworkClient::abort(QNetworkReply* reply) {
+    if (reply->thread() == QThread::currentThread()) {
+        reply->abort();
+        return;
+    }
+    QMetaObject::invokeMethod(reply, &QNetworkReply::abort, Qt::BlockingQueuedConnection);
+}
+
+void NetworkClient::warmUp() {
+    QMetaObject::invokeMethod(this, [this]() {
+        QUrl base(Config::WEBSERVER_BASE_URL);
+        m_manager->connectToHostEncrypted(base.host(), base.port(443));
+    }, Qt::QueuedConnection);
+}
+
+void NetworkClient::shutdown() {
+    m_thread.quit();
+    m_thread.wait();
+}
@@ -0,0 +1,96 @@
+#ifndef NETWORKCLIENT_H
+#define NETWORKCLIENT_H
+
+#include <QObject>
+#include <QThread>
+#include <QNetworkRequest>
+#include <QString>
+#include <functional>
+
+class QFile;
+class QNetworkAccessManager;
+class QNetworkReply;
+
+// Process-wide HTTP client shared by the workers.
+// One QNetworkAccessManager lives on a dedicated thread for the whole session,
+// so keep-alive connections (and HTTP/2 sessions) to the webserver are reused
+// across downloads instead of every worker paying a fresh TCP+TLS handshake.
+// get() may be called from any thread; the reply belongs to the network thread,
+// so release it with deleteLater() and abort it through abort().
+class NetworkClient : public QObject {
+    Q_OBJECT
+
+public:
+    static NetworkClient& instance();
+
+    // Adds the User-Agent and, for our own server, the access token. Public
+    // for requests sent through another manager, such as the RequestScheduler's.
+    static void prepare(QNetworkRequest& request);
+
+    // Sends the request after prepare()
+    QNetworkReply* get(QNetworkRequest request);
+    // Same, with onFinished connected (in context's thread) before the request can complete
+    QNetworkReply* get(QNetworkRequest request, QObject* context,
+                       const std::function<void(QNetworkReply*)>& onFinished);
+
+    struct DownloadResult {
+        bool ok = false;
+        bool timedOut = false;
+        int httpStatus = 0;
+        qint64 bytes = 0;       // size of the file on disk, including resumed bytes
+        qint64 resumedFrom = 0; // offset the transfer continued from, 0 for a fresh one
+        QString error;
+    };
+    // Streams the body to <path>.part chunk by chunk as it arrives, so memory stays
+    // flat whatever the size. Once the size is verified the file is fsynced and
+    // renamed over path. A failed transfer keeps the partial file plus a
+    // <path>.part.json sidecar (validator and offset), and the next call for the
+    // same URL continues with a Range request. Blocks the calling thread;
+    // onProgress runs on the network thread and counts resumed bytes.
+    DownloadResult download(QNetworkRequest request, const QString& path, int timeoutMs,
+                            const std::function<void(qint64, qint64)>& onProgress = nullptr);
+
+    // Hands the body to onData on the calling thread while it is still arriving,
+    // for consumers that process it as a stream. At most a couple of MB are
+    // queued between the threads; past that the reply stops being read and TCP
+    // flow control slows the sender. Returning false from onData aborts the
+    // transfer. Non-200 bodies are not passed on. Blocks the calling thread.
+    // With a path the body is also written to <path>.part exactly as download()
+    // would: a failed transfer keeps it and its sidecar for download() to resume,
+    // a complete one is moved to path. onData giving up then no longer aborts;
+    // the rest of the body still goes to the file and ok reports the file.
+    DownloadResult stream(QNetworkRequest request, int timeoutMs,
+                          const std::function<bool(const QByteArray&)>& onData,
+                          const std::function<void(qint64, qint64)>& onProgress = nullptr,
+                          const QString& path = QString());
+
+    // Blocks the calling thread until the reply finishes; on timeout aborts it and returns false
+    static bool waitForFinished(QNetworkReply* reply, int timeoutMs);
+    static void abort(QNetworkReply* reply);
+
+    // Opens the connection to the webserver ahead of the first request
+    void warmUp();
+
+private:
+    struct PartialDownload {
+        QString url;
+        QByteArray etag;
+        QByteArray lastModified;
+        qint64 offset = 0;
+        QByteArray validator() const { return etag.isEmpty() ? lastModified : etag; }
+    };
+
+    NetworkClient();
+    void shutdown();
+    static PartialDownload readPartial(const QString& path);
+    static void writePartial(const QString& path, const PartialDownload& state);
+    // Moves a finished <path>.part into place and sets result.ok, or on error keeps
+    // it for a Range request when resumable and a validator allows one
+    static void settlePartial(QFile& file, const QString& path, PartialDownload& state,
+                              DownloadResult& result, bool resumable);
+
+    QThread m_thread;
+    QNetworkAccessManager* m_manager = nullptr;
+};
+
+#endif // NETWORKCLIENT_H
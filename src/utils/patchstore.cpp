@@ -0,0 +1,52 @@
+#include "patchstore.h"
+#include "paths.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+namespace {
+    QString pathFor(const QByteArray& sha256) {
+        return QDir(PatchStore::directory()).filePath(QString::fromLatin1(sha256.toHex()) + ".lua");
+    }
+}
+
+QString PatchStore::directory() {
+    return QDir(Paths::getLocalCacheDir()).filePath("patches");
+}
+
+QByteArray PatchStore::hash(const QByteArray& data) {
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+}
+
+QString PatchStore::find(const QByteArray& sha256) {
+    if (sha256.isEmpty()) return QString();
+    QString path = pathFor(sha256);
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QString();
+
+    QCryptographicHash digest(QCryptographicHash::Sha256);
+    digest.addData(&file);
+    file.close();
+    if (digest.result() != sha256) {
+        QFile::remove(path);
+        return QString();
+    }
+    return path;
+}
+
+QString PatchStore::store(const QByteArray& data) {
+    QByteArray sha256 = hash(data);
+    QString existing = find(sha256);
+    if (!existing.isEmpty()) return existing;
+
+    QDir().mkpath(directory());
+    QString path = pathFor(sha256);
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return QString();
+    if (file.write(data) != data.size()) {
+        file.cancelWriting();
+        return QString();
+    }
+    return file.commit() ? path : QString();
+}
@@ -0,0 +1,22 @@
+#ifndef PATCHSTORE_H
+#define PATCHSTORE_H
+
+#include <QByteArray>
+#include <QString>
+
+// Content-addressed cache of downloaded Lua patches: <cache>/patches/<sha256>.lua.
+// Identical bytes are stored once however many games, libraries or versions
+// refer to them. A lookup re-hashes the file, so a damaged copy is dropped
+// instead of being handed out.
+class PatchStore {
+public:
+    static QString directory();
+    static QByteArray hash(const QByteArray& data);
+
+    // Path of a verified copy with this raw SHA-256 digest, or empty
+    static QString find(const QByteArray& sha256);
+    // Stores data under its own digest and returns the path, or empty on failure
+    static QString store(const QByteArray& data);
+};
+
+#endif // PATCHSTORE_H
@@ -18,3 +18,15 @@ QString Paths::getLocalCacheDir() {
 QString Paths::getLocalIndexPath() {
     return QDir(getLocalCacheDir()).filePath("games_index.json");
 }
+
+QString Paths::getLocalBinaryIndexPath() {
+    return QDir(getLocalCacheDir()).filePath("games_index.bin");
+}
+
+QString Paths::getLocalIndexMetaPath() {
+    return QDir(getLocalCacheDir()).filePath("games_index.meta.json");
+}
+
+QString Paths::getLocalNameCachePath() {
+    return QDir(getLocalCacheDir()).filePath("game_names.json");
+}
@@ -8,6 +8,9 @@ public:
     static QString getResourcePath(const QString& relativePath);
     static QString getLocalCacheDir();
     static QString getLocalIndexPath();
+    static QString getLocalBinaryIndexPath();
+    static QString getLocalIndexMetaPath();
+    static QString getLocalNameCachePath();
 };
 
 #endif // PATHS_H
@@ -0,0 +1,107 @@
+#include "requestscheduler.h"
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+
+namespace {
+    // Queued requests running at once; Interactive ones don't count against it
+    const int MAX_RUNNING = 6;
+    // Of those, how many may be speculative; keeps prefetch from eating the bandwidth
+    const int MAX_PREFETCH_RUNNING = 2;
+}
+
+RequestScheduler::RequestScheduler(QNetworkAccessManager* manager, QObject* parent)
+    : QObject(parent)
+    , m_manager(manager)
+{
+}
+
+QNetworkReply* RequestScheduler::getNow(const QNetworkRequest& request) {
+    QNetworkReply* reply = m_manager->get(request);
+    m_interactive++;
+    connect(reply, &QNetworkReply::finished, this, [this]() {
+        m_interactive--;
+        pump();
+    });
+    return reply;
+}
+
+RequestScheduler::Ticket RequestScheduler::enqueue(const QNetworkRequest& request, Priority priority,
+                                                   QObject* context, const Handler& handler) {
+    Ticket ticket = m_nextTicket++;
+    Job job;
+    job.request = request;
+    job.priority = priority;
+    job.context = context;
+    job.handler = handler;
+    m_jobs.insert(ticket, job);
+    m_queues[priority].append(ticket);
+    pump();
+    return ticket;
+}
+
+void RequestScheduler::setPriority(Ticket ticket, Priority priority) {
+    auto it = m_jobs.find(ticket);
+    if (it == m_jobs.end() || it->reply || it->priority == priority) return;
+    m_queues[it->priority].removeOne(ticket);
+    m_queues[priority].append(ticket);
+    it->priority = priority;
+    pump();
+}
+
+void RequestScheduler::cancel(Ticket ticket) {
+    auto it = m_jobs.find(ticket);
+    if (it == m_jobs.end()) return;
+    if (it->reply) {
+        // onFinished hands the aborted reply to the handler
+        it->reply->abort();
+        return;
+    }
+    Job job = m_jobs.take(ticket);
+    m_queues[job.priority].removeOne(ticket);
+    if (job.context && job.handler) job.handler(nullptr);
+}
+
+bool RequestScheduler::isStarted(Ticket ticket) const {
+    auto it = m_jobs.constFind(ticket);
+    return it != m_jobs.constEnd() && it->reply;
+}
+
+RequestScheduler::Priority RequestScheduler::priorityOf(Ticket ticket) const {
+    return m_jobs.value(ticket).priority;
+}
+
+void RequestScheduler::pump() {
+    // Interactive work never waits for a slot
+    while (!m_queues[Interactive].isEmpty()) start(m_queues[Interactive].takeFirst());
+
+    for (int priority = Visible; priority <= Background && m_running < MAX_RUNNING; ) {
+        if (m_queues[priority].isEmpty()
+            || (priority == Prefetch && m_runningPrefetch >= MAX_PREFETCH_RUNNING)) {
+            ++priority;
+            continue;
+        }
+        // While a search is running only what's on screen may start
+        if (priority > Visible && m_interactive > 0) break;
+        start(m_queues[priority].takeFirst());
+    }
+}
+
+void RequestScheduler::start(Ticket ticket) {
+    Job& job = m_jobs[ticket];
+    job.reply = m_manager->get(job.request);
+    // Interactive jobs take no slot; like getNow() they hold back everything below Visible
+    if (job.priority == Interactive) m_interactive++;
+    else m_running++;
+    if (job.priority == Prefetch) m_runningPrefetch++;
+    connect(job.reply, &QNetworkReply::finished, this, [this, ticket]() { onFinished(ticket); });
+}
+
+void RequestScheduler::onFinished(Ticket ticket) {
+    Job job = m_jobs.take(ticket);
+    if (job.priority == Interactive) m_interactive--;
+    else m_running--;
+    if (job.priority == Prefetch) m_runningPrefetch--;
+    if (job.context && job.handler) job.handler(job.reply);
+    job.reply->deleteLater();
+    pump();
+}
@@ -0,0 +1,67 @@
+#ifndef REQUESTSCHEDULER_H
+#define REQUESTSCHEDULER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <functional>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+// Orders the GUI's own HTTP traffic (search, names, thumbnails) by how much
+// the user is waiting for it. Interactive requests start at once; everything
+// else waits for one of a few slots, highest class first, and nothing below
+// Visible starts while a search is in flight; Prefetch only ever gets a
+// couple of the slots. Queued work can be moved to another class or
+// cancelled as the viewport moves.
+// GUI thread only, like the QNetworkAccessManager it wraps.
+class RequestScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    enum Priority { Interactive, Visible, Prefetch, Background };
+    using Ticket = quint64;
+    // Called with the finished reply (the scheduler deletes it afterwards), or
+    // with nullptr when the request was cancelled before it started
+    using Handler = std::function<void(QNetworkReply*)>;
+
+    explicit RequestScheduler(QNetworkAccessManager* manager, QObject* parent = nullptr);
+
+    // Starts right away; the caller owns the reply as with QNetworkAccessManager::get
+    QNetworkReply* getNow(const QNetworkRequest& request);
+    // Queues the request; handler runs once it is done unless context is gone by then
+    Ticket enqueue(const QNetworkRequest& request, Priority priority, QObject* context, const Handler& handler);
+
+    // Only affects requests that haven't started yet
+    void setPriority(Ticket ticket, Priority priority);
+    // A queued request is dropped (handler gets nullptr), a running one aborted
+    void cancel(Ticket ticket);
+    bool isStarted(Ticket ticket) const;
+    Priority priorityOf(Ticket ticket) const;
+
+private:
+    struct Job {
+        QNetworkRequest request;
+        Priority priority = Background;
+        QPointer<QObject> context;
+        Handler handler;
+        QNetworkReply* reply = nullptr;
+    };
+
+    void pump();
+    void start(Ticket ticket);
+    void onFinished(Ticket ticket);
+
+    QNetworkAccessManager* m_manager;
+    QHash<Ticket, Job> m_jobs;
+    QList<Ticket> m_queues[Background + 1];
+    int m_running = 0;
+    int m_runningPrefetch = 0;
+    int m_interactive = 0;
+    Ticket m_nextTicket = 1;
+};
+
+#endif // REQUESTSCHEDULER_H
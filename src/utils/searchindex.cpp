@@ -0,0 +1,245 @@
+#include "searchindex.h"
+#include <QBitArray>
+#include <algorithm>
+#include <queue>
+#include <vector>
+
+namespace {
+    // Upper bound on rows scored for one query; the best-overlapping ones are kept
+    const int MAX_CANDIDATES = 4000;
+
+    int maxEditsFor(int length) {
+        if (length >= 8) return 2;
+        if (length >= 4) return 1;
+        return 0;
+    }
+
+    bool isBetter(const SearchIndex::Hit& a, const SearchIndex::Hit& b) {
+        return a.score > b.score || (a.score == b.score && a.row < b.row);
+    }
+}
+
+SearchIndex SearchIndex::build(const GameCatalogue& catalogue) {
+    SearchIndex index;
+    int count = catalogue.size();
+    index.m_tokens.reserve(count);
+    index.m_compact.reserve(count);
+    index.m_trigrams.reserve(count * 4);
+    index.m_words.reserve(count * 3);
+
+    for (int row = 0; row < count; ++row) {
+        QStringList tokens = tokenize(catalogue.name(row));
+        QString compact = tokens.join(QString());
+
+        // Trigram postings over the joined tokens, one entry per (trigram, row)
+        const QChar* p = compact.constData();
+        for (int i = 0; i + 3 <= compact.size(); ++i) {
+            QVector<int>& postings = index.m_trigrams[trigramKey(p + i)];
+            if (postings.isEmpty() || postings.last() != row) postings.append(row);
+        }
+
+        // Word starts for short prefix queries
+        for (const QString& token : tokens) {
+            index.m_words.append({ token, row });
+        }
+
+        index.m_tokens.append(tokens);
+        index.m_compact.append(compact);
+    }
+
+    std::sort(index.m_words.begin(), index.m_words.end(),
+              [](const WordEntry& a, const WordEntry& b) { return a.word < b.word; });
+    return index;
+}
+
+QStringList SearchIndex::tokenize(const QString& text) {
+    // Compatibility decomposition splits accents off so they can be dropped
+    QString normalized = text.normalized(QString::NormalizationForm_KD).toCaseFolded();
+
+    QStringList tokens;
+    QString current;
+    int currentKind = 0; // 0 = separator, 1 = letters, 2 = digits
+    for (const QChar& c : normalized) {
+        if (c.isMark()) continue;
+        int kind = c.isDigit() ? 2 : (c.isLetter() ? 1 : 0);
+        if (kind != currentKind && !current.isEmpty()) {
+            tokens.append(current);
+            current.clear();
+        }
+        if (kind != 0) current.append(c);
+        currentKind = kind;
+    }
+    if (!current.isEmpty()) tokens.append(current);
+    return tokens;
+}
+
+quint64 SearchIndex::trigramKey(const QChar* p) {
+    return (quint64(p[0].unicode()) << 32) | (quint64(p[1].unicode()) << 16) | quint64(p[2].unicode());
+}
+
+int SearchIndex::boundedDistance(const QString& a, const QString& b, int maxDistance) {
+    // Optimal string alignment distance; gives up once every cell exceeds the bound
+    int n = a.size();
+    int m = b.size();
+    if (qAbs(n - m) > maxDistance) return maxDistance + 1;
+
+    QVector<int> prevPrev(m + 1), prev(m + 1), cur(m + 1);
+    for (int j = 0; j <= m; ++j) prev[j] = j;
+    for (int i = 1; i <= n; ++i) {
+        cur[0] = i;
+        int rowMin = cur[0];
+        for (int j = 1; j <= m; ++j) {
+            int cost = (a[i - 1] == b[j - 1]) ? 0 : 1;
+            int value = qMin(qMin(prev[j] + 1, cur[j - 1] + 1), prev[j - 1] + cost);
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                value = qMin(value, prevPrev[j - 2] + 1);
+            }
+            cur[j] = value;
+            rowMin = qMin(rowMin, value);
+        }
+        if (rowMin > maxDistance) return maxDistance + 1;
+        prevPrev.swap(prev);
+        prev.swap(cur);
+    }
+    return prev[m];
+}
+
+int SearchIndex::tokenScore(const QString& queryToken, const QString& nameToken) {
+    if (nameToken == queryToken) return 100;
+    if (nameToken.startsWith(queryToken)) {
+        return 80 - qMin(20, int(nameToken.size() - queryToken.size()));
+    }
+    if (queryToken.size() >= 3 && nameToken.contains(queryToken)) return 50;
+
+    // Typos only count on words long enough to tell them apart; numbers must match
+    int maxEdits = maxEditsFor(queryToken.size());
+    if (maxEdits == 0 || queryToken[0].isDigit()) return 0;
+
+    int best = 0;
+    int d = boundedDistance(queryToken, nameToken, maxEdits);
+    if (d <= maxEdits) best = 60 - 20 * d;
+    if (nameToken.size() > queryToken.size()) {
+        // Misspelled prefix of a longer word
+        int dp = boundedDistance(queryToken, nameToken.left(queryToken.size()), maxEdits);
+        if (dp <= maxEdits) best = qMax(best, 45 - 20 * dp);
+    }
+    return best;
+}
+
+int SearchIndex::score(int row, const QStringList& queryTokens, const QString& compactQuery) const {
+    const QStringList& nameTokens = m_tokens[row];
+    const QString& compact = m_compact[row];
+
+    int total = 0;
+    bool allTokensMatched = true;
+    for (const QString& q : queryTokens) {
+        int best = 0;
+        for (const QString& t : nameTokens) {
+            best = qMax(best, tokenScore(q, t));
+            if (best == 100) break;
+        }
+        if (best == 0) allTokensMatched = false;
+        total += best;
+    }
+
+    int phrase = 0;
+    if (compact == compactQuery) phrase = 400;
+    else if (compact.startsWith(compactQuery)) phrase = 250;
+    else if (compact.contains(compactQuery)) phrase = 150;
+
+    if (!allTokensMatched && phrase == 0) return 0;
+
+    // Prefer names that are not much longer than what was typed
+    total += phrase - qMin(30, int(qAbs(compact.size() - compactQuery.size())) / 2);
+    return qMax(total, 1);
+}
+
+QVector<int> SearchIndex::candidates(const QString& compactQuery, const QStringList& queryTokens) const {
+    QVector<int> rows;
+
+    if (compactQuery.size() < 3) {
+        // Too short for trigrams: words starting with the first token
+        const QString& prefix = queryTokens.first();
+        auto it = std::lower_bound(m_words.cbegin(), m_words.cend(), prefix,
+                                   [](const WordEntry& e, const QString& q) { return e.word < q; });
+        QBitArray hits(size());
+        for (; it != m_words.cend() && it->word.startsWith(prefix); ++it) {
+            hits.setBit(it->row);
+        }
+        for (int row = 0; row < hits.size(); ++row) {
+            if (hits.testBit(row)) rows.append(row);
+        }
+        return rows;
+    }
+
+    // Count shared trigrams per row
+    QVector<quint64> keys;
+    const QChar* p = compactQuery.constData();
+    for (int i = 0; i + 3 <= compactQuery.size(); ++i) {
+        quint64 key = trigramKey(p + i);
+        if (!keys.contains(key)) keys.append(key);
+    }
+
+    QVector<quint16> overlap(size(), 0);
+    QVector<int> touched;
+    for (quint64 key : keys) {
+        auto it = m_trigrams.constFind(key);
+        if (it == m_trigrams.constEnd()) continue;
+        for (int row : it.value()) {
+            if (overlap[row]++ == 0) touched.append(row);
+        }
+    }
+
+    // Each edit can break up to three trigrams
+    int total = keys.size();
+    int threshold = qMax(1, total - 3 * maxEditsFor(compactQuery.size()));
+
+    QVector<int> histogram(total + 1, 0);
+    for (int row : touched) histogram[overlap[row]]++;
+    int kept = 0;
+    for (int c = total; c >= threshold; --c) kept += histogram[c];
+    while (kept > MAX_CANDIDATES && threshold < total) {
+        kept -= histogram[threshold];
+        threshold++;
+    }
+
+    for (int row : touched) {
+        if (overlap[row] >= threshold) rows.append(row);
+    }
+    return rows;
+}
+
+QVector<SearchIndex::Hit> SearchIndex::rankedSearch(const QString& query, int k,
+                                                    const std::function<bool(int)>& filter) const {
+    QVector<Hit> result;
+    if (k <= 0 || isEmpty()) return result;
+
+    QStringList queryTokens = tokenize(query);
+    if (queryTokens.isEmpty()) return result;
+    QString compactQuery = queryTokens.join(QString());
+
+    // Min-heap on quality: the worst of the current top k sits on top
+    auto worseOnTop = [](const Hit& a, const Hit& b) { return isBetter(a, b); };
+    std::priority_queue<Hit, std::vector<Hit>, decltype(worseOnTop)> heap(worseOnTop);
+
+    for (int row : candidates(compactQuery, queryTokens)) {
+        if (filter && !filter(row)) continue;
+        int s = score(row, queryTokens, compactQuery);
+        if (s <= 0) continue;
+        Hit hit{ row, s };
+        if (int(heap.size()) < k) {
+            heap.push(hit);
+        } else if (isBetter(hit, heap.top())) {
+            heap.pop();
+            heap.push(hit);
+        }
+    }
+
+    result.reserve(int(heap.size()));
+    while (!heap.empty()) {
+        result.append(heap.top());
+        heap.pop();
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
@@ -0,0 +1,57 @@
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QMetaType>
+#include <functional>
+#include "gamecatalogue.h"
+
+// Normalised name index over a GameCatalogue.
+// Names are case-folded, stripped of accents and punctuation and split into
+// letter/digit tokens ("The Witcher 3" -> the, witcher, 3). Trigrams of the
+// joined tokens select candidates, which are then scored by exact, prefix,
+// substring and edit-distance token matches; only the best k are kept.
+class SearchIndex {
+public:
+    struct Hit {
+        int row;
+        int score;
+    };
+
+    SearchIndex() = default;
+
+    static SearchIndex build(const GameCatalogue& catalogue);
+    static QStringList tokenize(const QString& text);
+
+    bool isEmpty() const { return m_compact.isEmpty(); }
+    int size() const { return m_compact.size(); }
+
+    // Best matches first, at most k of them
+    QVector<Hit> rankedSearch(const QString& query, int k,
+                              const std::function<bool(int)>& filter = nullptr) const;
+
+private:
+    struct WordEntry {
+        QString word;
+        int row;
+    };
+
+    static quint64 trigramKey(const QChar* p);
+    static int boundedDistance(const QString& a, const QString& b, int maxDistance);
+    static int tokenScore(const QString& queryToken, const QString& nameToken);
+
+    int score(int row, const QStringList& queryTokens, const QString& compactQuery) const;
+    QVector<int> candidates(const QString& compactQuery, const QStringList& queryTokens) const;
+
+    QVector<QStringList> m_tokens;
+    QVector<QString> m_compact;
+    QHash<quint64, QVector<int>> m_trigrams;
+    QVector<WordEntry> m_words;
+};
+
+Q_DECLARE_METATYPE(SearchIndex)
+
+#endif // SEARCHINDEX_H
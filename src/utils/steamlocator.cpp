@@ -0,0 +1,434 @@
+#include "steamlocator.h"
+#include "paths.h"
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+#include <QSettings>
+#include <QThread>
+#include <QTimer>
+#include <memory>
+
+namespace {
+    // How long one discovery round waits for a slow drive before leaving it out
+    const int DRIVE_TIMEOUT_MS = 3000;
+    // Steam rewrites several files at once; let them settle before checking again
+    const int WATCH_DEBOUNCE_MS = 1000;
+
+    QString normalized(const QString& path) {
+        QString clean = QDir::cleanPath(QDir::fromNativeSeparators(path.trimmed()));
+        if (clean.size() > 3 && clean.endsWith('/')) clean.chop(1);
+        return clean;
+    }
+
+    QString keyOf(const QString& path) {
+#ifdef Q_OS_WIN
+        return path.toLower();
+#else
+        return path;
+#endif
+    }
+
+    // Candidates on the same drive are probed by the same task, so a drive
+    // that hangs holds up nothing but itself
+    QString driveOf(const QString& path) {
+        if (path.size() >= 2 && path.at(1) == ':') return path.left(2).toUpper();
+        if (path.startsWith("//")) return path.section('/', 0, 3);
+        return "/";
+    }
+
+    QString pluginDirOf(const QString& root) { return root + "/config/stplug-in"; }
+    QString exeOf(const QString& root) { return root + "/Steam.exe"; }
+    QString libraryFoldersVdfOf(const QString& root) { return root + "/steamapps/libraryfolders.vdf"; }
+
+    void appendUnique(QStringList& list, QSet<QString>& seen, const QString& path) {
+        if (path.isEmpty()) return;
+        if (seen.contains(keyOf(path))) return;
+        seen.insert(keyOf(path));
+        list.append(path);
+    }
+
+    QStringList readLibraryFolders(const QString& root) {
+        QFile file(libraryFoldersVdfOf(root));
+        if (!file.open(QIODevice::ReadOnly)) return QStringList();
+        QString text = QString::fromUtf8(file.readAll());
+
+        // Current files give each library a "path" key; older ones map "1", "2"... straight to the path
+        static const QRegularExpression pattern(R"re("(?:path|\d+)"\s+"((?:[^"\\]|\\.)*)")re");
+        QStringList folders;
+        QSet<QString> seen;
+        for (auto it = pattern.globalMatch(text); it.hasNext(); ) {
+            QString value = it.next().captured(1);
+            value.replace("\\\\", "\\");
+            // "1" "..." entries in newer files are app IDs and sizes, not paths
+            if (!value.contains('/') && !value.contains('\\')) continue;
+            appendUnique(folders, seen, normalized(value));
+        }
+        return folders;
+    }
+
+    QStringList toStringList(const QJsonValue& value) {
+        QStringList list;
+        for (const QJsonValue& item : value.toArray()) list.append(item.toString());
+        return list;
+    }
+}
+
+SteamLocator& SteamLocator::instance() {
+    // Deliberately never destroyed, like NetworkClient
+    static SteamLocator* locator = new SteamLocator();
+    return *locator;
+}
+
+SteamLocator::SteamLocator() {
+    // Plenty of threads so a few hung drives can't starve the next discovery
+    m_pool.setMaxThreadCount(32);
+    m_snapshot = readCache();
+
+    // The watcher needs an event loop; it lives on the GUI thread whoever asks first
+    if (QCoreApplication* app = QCoreApplication::instance()) {
+        moveToThread(app->thread());
+        QMetaObject::invokeMethod(this, [this]() {
+            m_refreshTimer = new QTimer(this);
+            m_refreshTimer->setSingleShot(true);
+            m_refreshTimer->setInterval(WATCH_DEBOUNCE_MS);
+            connect(m_refreshTimer, &QTimer::timeout, this, [this]() {
+                QMutexLocker lock(&m_mutex);
+                for (const QString& root : m_changedRoots) {
+                    if (!m_dirtyRoots.contains(root)) m_dirtyRoots.append(root);
+                }
+                m_changedRoots.clear();
+                schedule();
+            });
+
+            m_watcher = new QFileSystemWatcher(this);
+            connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &SteamLocator::onWatchEvent);
+            connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &SteamLocator::onWatchEvent);
+            updateWatches();
+        }, Qt::QueuedConnection);
+    }
+
+    // Serve the cached locations right away and check them once in the background
+    refresh();
+}
+
+SteamLocator::Found SteamLocator::probeRoot(const QString& root, bool readLibraries) {
+    Found entry;
+    entry.root = root;
+    entry.hasExe = QFileInfo(exeOf(root)).isFile();
+    entry.hasPluginDir = QFileInfo(pluginDirOf(root)).isDir();
+    if (readLibraries && (entry.hasExe || entry.hasPluginDir)) entry.libraries = readLibraryFolders(root);
+    return entry;
+}
+
+// Probes the candidates on worker threads, one task per drive, and returns
+// what was found in candidate order. Drives still busy at the deadline are
+// skipped; their tasks finish in the background and are ignored.
+QVector<SteamLocator::Found> SteamLocator::probeCandidates(QThreadPool& pool, const QStringList& candidates,
+                                                           bool readLibraries) {
+    struct Batch {
+        QMutex mutex;
+        QWaitCondition done;
+        int pending = 0;
+        QHash<int, Found> found;
+    };
+    auto batch = std::make_shared<Batch>();
+
+    QHash<QString, QVector<int>> byDrive;
+    QStringList driveOrder;
+    for (int i = 0; i < candidates.size(); ++i) {
+        QString drive = driveOf(candidates[i]);
+        if (!byDrive.contains(drive)) driveOrder.append(drive);
+        byDrive[drive].append(i);
+    }
+
+    batch->pending = driveOrder.size();
+    for (const QString& drive : driveOrder) {
+        QVector<int> indices = byDrive.value(drive);
+        pool.start([batch, candidates, indices, readLibraries]() {
+            QHash<int, Found> found;
+            for (int i : indices) {
+                Found entry = probeRoot(candidates[i], readLibraries);
+                if (entry.hasExe || entry.hasPluginDir) found.insert(i, entry);
+            }
+            QMutexLocker lock(&batch->mutex);
+            batch->found.insert(found);
+            if (--batch->pending == 0) batch->done.wakeAll();
+        });
+    }
+
+    QMutexLocker lock(&batch->mutex);
+    QDeadlineTimer deadline(DRIVE_TIMEOUT_MS);
+    while (batch->pending > 0) {
+        if (!batch->done.wait(&batch->mutex, deadline)) break;
+    }
+    QVector<Found> result;
+    for (int i = 0; i < candidates.size(); ++i) {
+        auto it = batch->found.constFind(i);
+        if (it != batch->found.constEnd()) result.append(*it);
+    }
+    return result;
+}
+
+QStringList SteamLocator::steamRoots() { return snapshot().roots; }
+QStringList SteamLocator::pluginDirs() { return snapshot().pluginDirs; }
+QStringList SteamLocator::exePaths() { return snapshot().exePaths; }
+QStringList SteamLocator::libraryFolders() { return snapshot().libraryFolders; }
+
+bool SteamLocator::isReady() {
+    QMutexLocker lock(&m_mutex);
+    return m_snapshot.valid;
+}
+
+SteamLocator::Snapshot SteamLocator::snapshot() {
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_snapshot.valid) return m_snapshot;
+        // Only without a cache file: worker threads wait for the first discovery
+        if (QThread::currentThread() != thread()) {
+            while (!m_snapshot.valid) m_ready.wait(&m_mutex);
+            return m_snapshot;
+        }
+    }
+    // The GUI thread never waits on a drive sweep; until the first one is done it
+    // gets the installations the registry names, and changed() follows
+    QVector<Found> found;
+    for (const QString& root : registryRoots()) {
+        Found entry = probeRoot(root, true);
+        if (entry.hasExe || entry.hasPluginDir) found.append(entry);
+    }
+    Snapshot fallback = assemble(found);
+    fallback.valid = false;
+    return fallback;
+}
+
+void SteamLocator::refresh() {
+    QMutexLocker lock(&m_mutex);
+    m_sweepPending = true;
+    schedule();
+}
+
+// Called with m_mutex held; a running work() picks up whatever is pending
+void SteamLocator::schedule() {
+    if (m_discovering || (!m_sweepPending && m_dirtyRoots.isEmpty())) return;
+    m_discovering = true;
+    m_pool.start([this]() { work(); });
+}
+
+void SteamLocator::work() {
+    while (true) {
+        bool full;
+        QStringList dirty;
+        {
+            QMutexLocker lock(&m_mutex);
+            if (!m_sweepPending && m_dirtyRoots.isEmpty()) {
+                m_discovering = false;
+                return;
+            }
+            // A sweep checks the changed roots as well
+            full = m_sweepPending;
+            dirty = m_dirtyRoots;
+            m_sweepPending = false;
+            m_dirtyRoots.clear();
+        }
+        publish(full ? sweep() : recheck(dirty));
+    }
+}
+
+QVector<SteamLocator::Found> SteamLocator::sweep() {
+    QStringList candidates;
+    QSet<QString> seen;
+    for (const QString& root : registryRoots()) appendUnique(candidates, seen, root);
+    for (const QFileInfo& drive : QDir::drives()) {
+        QString d = normalized(drive.absoluteFilePath());
+        if (!d.endsWith('/')) d += '/';
+        appendUnique(candidates, seen, d + "Program Files (x86)/Steam");
+        appendUnique(candidates, seen, d + "Program Files/Steam");
+        appendUnique(candidates, seen, d + "Steam");
+    }
+    QVector<Found> found = probeCandidates(m_pool, candidates, true);
+
+    // Library folders can be further Steam installations on drives not probed yet
+    QStringList extra;
+    for (const Found& entry : found) {
+        for (const QString& library : entry.libraries) {
+            if (!seen.contains(keyOf(library))) appendUnique(extra, seen, library);
+        }
+    }
+    if (!extra.isEmpty()) found += probeCandidates(m_pool, extra, false);
+    return found;
+}
+
+// Probes only the given roots again; every other root keeps what the last pass found
+QVector<SteamLocator::Found> SteamLocator::recheck(const QStringList& roots) {
+    Snapshot current;
+    {
+        QMutexLocker lock(&m_mutex);
+        current = m_snapshot;
+    }
+    QHash<QString, Found> fresh;
+    for (const Found& entry : probeCandidates(m_pool, roots, true)) fresh.insert(keyOf(entry.root), entry);
+    QSet<QString> dirty;
+    for (const QString& root : roots) dirty.insert(keyOf(root));
+
+    QVector<Found> found;
+    QSet<QString> seen;
+    for (const QString& root : current.roots) {
+        seen.insert(keyOf(root));
+        if (dirty.contains(keyOf(root))) {
+            // Left out once it holds neither Steam.exe nor config/stplug-in
+            auto it = fresh.constFind(keyOf(root));
+            if (it != fresh.constEnd()) found.append(*it);
+            continue;
+        }
+        Found entry;
+        entry.root = root;
+        entry.hasExe = current.exePaths.contains(exeOf(root));
+        entry.hasPluginDir = current.pluginDirs.contains(pluginDirOf(root));
+        entry.libraries = current.librariesOf.value(keyOf(root));
+        found.append(entry);
+    }
+
+    // A library added to libraryfolders.vdf may be another installation
+    QStringList extra;
+    for (const Found& entry : fresh) {
+        for (const QString& library : entry.libraries) {
+            if (!seen.contains(keyOf(library))) appendUnique(extra, seen, library);
+        }
+    }
+    if (!extra.isEmpty()) found += probeCandidates(m_pool, extra, false);
+    return found;
+}
+
+SteamLocator::Snapshot SteamLocator::assemble(const QVector<Found>& found) {
+    Snapshot snapshot;
+    snapshot.valid = true;
+    QSet<QString> seenRoots;
+    QSet<QString> seenLibraries;
+    for (const Found& entry : found) {
+        if (seenRoots.contains(keyOf(entry.root))) continue;
+        seenRoots.insert(keyOf(entry.root));
+        snapshot.roots.append(entry.root);
+        if (entry.hasPluginDir) snapshot.pluginDirs.append(pluginDirOf(entry.root));
+        if (entry.hasExe) snapshot.exePaths.append(exeOf(entry.root));
+        snapshot.librariesOf.insert(keyOf(entry.root), entry.libraries);
+        for (const QString& library : entry.libraries) appendUnique(snapshot.libraryFolders, seenLibraries, library);
+    }
+    return snapshot;
+}
+
+void SteamLocator::publish(const QVector<Found>& found) {
+    Snapshot next = assemble(found);
+    bool differs;
+    {
+        QMutexLocker lock(&m_mutex);
+        differs = !m_snapshot.valid
+            || next.roots != m_snapshot.roots
+            || next.pluginDirs != m_snapshot.pluginDirs
+            || next.exePaths != m_snapshot.exePaths
+            || next.libraryFolders != m_snapshot.libraryFolders;
+        m_snapshot = next;
+        m_ready.wakeAll();
+    }
+    if (differs) writeCache(next);
+    QMetaObject::invokeMethod(this, [this, differs]() { onDiscovered(differs); }, Qt::QueuedConnection);
+}
+
+void SteamLocator::onDiscovered(bool differs) {
+    updateWatches();
+    if (differs) emit changed();
+}
+
+// Maps the watched path back to its root; checked again after the debounce
+void SteamLocator::onWatchEvent(const QString& path) {
+    QString changed = keyOf(normalized(path));
+    QStringList roots;
+    {
+        QMutexLocker lock(&m_mutex);
+        roots = m_snapshot.roots;
+    }
+    for (const QString& root : roots) {
+        if (changed == keyOf(root) || changed == keyOf(root + "/config")
+            || changed == keyOf(libraryFoldersVdfOf(root))) {
+            if (!m_changedRoots.contains(root)) m_changedRoots.append(root);
+            m_refreshTimer->start();
+            return;
+        }
+    }
+}
+
+void SteamLocator::updateWatches() {
+    if (!m_watcher) return;
+    // Re-added every time: Steam replaces libraryfolders.vdf rather than editing it,
+    // which drops the watch on the old file
+    QStringList watched = m_watcher->files() + m_watcher->directories();
+    if (!watched.isEmpty()) m_watcher->removePaths(watched);
+
+    QStringList roots;
+    {
+        QMutexLocker lock(&m_mutex);
+        roots = m_snapshot.roots;
+    }
+    QStringList paths;
+    for (const QString& root : roots) {
+        for (const QString& path : {root, root + "/config", libraryFoldersVdfOf(root)}) {
+            if (QFileInfo::exists(path)) paths.append(path);
+        }
+    }
+    if (!paths.isEmpty()) m_watcher->addPaths(paths);
+}
+
+QStringList SteamLocator::registryRoots() {
+    QStringList roots;
+#ifdef Q_OS_WIN
+    // The current user's Steam first: that is the one the client actually runs from
+    const QList<QPair<QString, QString>> keys = {
+        {"HKEY_CURRENT_USER\\Software\\Valve\\Steam", "SteamPath"},
+        {"HKEY_LOCAL_MACHINE\\SOFTWARE\\WOW6432Node\\Valve\\Steam", "InstallPath"},
+        {"HKEY_LOCAL_MACHINE\\SOFTWARE\\Valve\\Steam", "InstallPath"},
+    };
+    for (const auto& key : keys) {
+        QString path = QSettings(key.first, QSettings::NativeFormat).value(key.second).toString();
+        if (!path.isEmpty()) roots.append(normalized(path));
+    }
+#endif
+    return roots;
+}
+
+SteamLocator::Snapshot SteamLocator::readCache() {
+    Snapshot snapshot;
+    QFile file(QDir(Paths::getLocalCacheDir()).filePath("steam_locations.json"));
+    if (!file.open(QIODevice::ReadOnly)) return snapshot;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isObject()) return snapshot;
+
+    QJsonObject obj = doc.object();
+    snapshot.roots = toStringList(obj.value("roots"));
+    snapshot.pluginDirs = toStringList(obj.value("plugin_dirs"));
+    snapshot.exePaths = toStringList(obj.value("exe_paths"));
+    snapshot.libraryFolders = toStringList(obj.value("library_folders"));
+    snapshot.valid = true;
+    return snapshot;
+}
+
+void SteamLocator::writeCache(const Snapshot& snapshot) {
+    QJsonObject obj;
+    obj["roots"] = QJsonArray::fromStringList(snapshot.roots);
+    obj["plugin_dirs"] = QJsonArray::fromStringList(snapshot.pluginDirs);
+    obj["exe_paths"] = QJsonArray::fromStringList(snapshot.exePaths);
+    obj["library_folders"] = QJsonArray::fromStringList(snapshot.libraryFolders);
+
+    QSaveFile file(QDir(Paths::getLocalCacheDir()).filePath("steam_locations.json"));
+    if (!file.open(QIODevice::WriteOnly)) return;
+    file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    file.commit();
+}
@@ -0,0 +1,99 @@
+#ifndef STEAMLOCATOR_H
+#define STEAMLOCATOR_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+#include <QWaitCondition>
+
+class QFileSystemWatcher;
+class QTimer;
+
+// Knows where Steam is installed so callers don't have to go looking.
+// Discovery combines the registry, every root's steamapps/libraryfolders.vdf
+// and the usual folders on each drive; drives are probed in parallel on a
+// private pool, and one that doesn't answer in time (an empty card reader, a
+// sleeping network share) is left out rather than stalling the rest.
+// The result is kept in memory and in <cache>/steam_locations.json. It is
+// rediscovered once per session in the background and on refresh(). When a
+// watched root, config folder or libraryfolders.vdf changes, only that root
+// is checked again.
+// The getters are cheap and may be called from any thread. On the very first
+// run, before any discovery has completed, other threads block until it has;
+// the GUI thread gets only the registry's installations instead.
+class SteamLocator : public QObject {
+    Q_OBJECT
+
+public:
+    static SteamLocator& instance();
+
+    // Steam folders holding Steam.exe or a config/stplug-in, most likely first
+    QStringList steamRoots();
+    QStringList pluginDirs();
+    QStringList exePaths();
+    // Every library folder listed in libraryfolders.vdf
+    QStringList libraryFolders();
+    // False only on a first run until discovery completes; the getters then
+    // block, or on the GUI thread answer from the registry alone
+    bool isReady();
+
+    // Sweeps every drive again, after the discovery already running if any
+    void refresh();
+
+signals:
+    // Emitted on the GUI thread when a discovery found something different
+    void changed();
+
+private:
+    // One Steam folder as found on disk
+    struct Found {
+        QString root;
+        bool hasExe = false;
+        bool hasPluginDir = false;
+        QStringList libraries;
+    };
+    struct Snapshot {
+        QStringList roots;
+        QStringList pluginDirs;
+        QStringList exePaths;
+        QStringList libraryFolders;
+        QHash<QString, QStringList> librariesOf; // root key -> its libraries; not in the cache file
+        bool valid = false;
+    };
+
+    SteamLocator();
+    Snapshot snapshot();
+    void schedule();
+    void work();
+    QVector<Found> sweep();
+    QVector<Found> recheck(const QStringList& roots);
+    void publish(const QVector<Found>& found);
+    void onDiscovered(bool differs);
+    void onWatchEvent(const QString& path);
+    void updateWatches();
+
+    static Found probeRoot(const QString& root, bool readLibraries);
+    static QVector<Found> probeCandidates(QThreadPool& pool, const QStringList& candidates, bool readLibraries);
+    static Snapshot assemble(const QVector<Found>& found);
+    static QStringList registryRoots();
+    static Snapshot readCache();
+    static void writeCache(const Snapshot& snapshot);
+
+    QThreadPool m_pool;
+    QMutex m_mutex;
+    QWaitCondition m_ready;
+    Snapshot m_snapshot;
+    bool m_discovering = false;     // work() is running or queued on the pool
+    bool m_sweepPending = false;
+    QStringList m_dirtyRoots;       // to check again on the next pass
+
+    // GUI thread only
+    QFileSystemWatcher* m_watcher = nullptr;
+    QTimer* m_refreshTimer = nullptr;
+    QStringList m_changedRoots;     // seen by the watcher, waiting out the debounce
+};
+
+#endif // STEAMLOCATOR_H
@@ -0,0 +1,398 @@
+#include "thumbnailcache.h"
+#include "paths.h"
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRunnable>
+#include <QThread>
+
+namespace {
+    const qint64 MEMORY_BUDGET_KB = 64 * 1024;          // decoded pixmaps
+    const qint64 DISK_BUDGET_BYTES = 256LL * 1024 * 1024; // downloaded files
+    const qint64 REVALIDATE_AFTER_SECS = 7 * 24 * 3600;
+    // Prefetched pixmaps have their own, smaller LRU until a card shows them,
+    // so scrolling ahead can only evict other prefetches
+    const qint64 PREFETCH_BUDGET_KB = MEMORY_BUDGET_KB / 4;
+
+    qint64 costOf(const QPixmap& pixmap) {
+        return qMax<qint64>(1, qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8 / 1024);
+    }
+
+    QString metaPathFor(const QString& path) {
+        return path + ".json";
+    }
+}
+
+// Runs on the cache's pool: reads the disk copy (or persists a fresh download),
+// decodes it and scales it to the card size, then hands the QImage back.
+class ThumbnailDecodeTask : public QRunnable {
+public:
+    ThumbnailDecodeTask(ThumbnailCache* cache, const QString& appId, const QString& path,
+                        const QByteArray& data, const ThumbnailCache::DiskMeta& meta,
+                        const QSize& targetSize, qreal devicePixelRatio, int generation)
+        : m_cache(cache), m_appId(appId), m_path(path), m_data(data), m_meta(meta)
+        , m_targetSize(targetSize), m_devicePixelRatio(devicePixelRatio), m_generation(generation)
+    {
+    }
+
+    void run() override {
+        bool fromDisk = m_data.isEmpty();
+        ThumbnailCache::DiskMeta meta = m_meta;
+        if (fromDisk) {
+            QFile file(m_path);
+            if (file.open(QIODevice::ReadOnly)) {
+                m_data = file.readAll();
+                file.close();
+                ThumbnailCache::readMeta(metaPathFor(m_path), meta);
+            }
+        }
+
+        QImage image;
+        if (!m_data.isEmpty() && image.loadFromData(m_data)) {
+            if (m_targetSize.isValid()) {
+                // Exactly the card's device pixels so painting never rescales
+                QSize pixels = (QSizeF(m_targetSize) * m_devicePixelRatio).toSize();
+                image = image.scaled(pixels, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+                image.setDevicePixelRatio(m_devicePixelRatio);
+            }
+            image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        }
+
+        qint64 bytesWritten = 0;
+        if (!image.isNull()) {
+            if (fromDisk) {
+                // Bump the modification time so eviction drops the least recently shown first
+                QFile touch(m_path);
+                if (touch.open(QIODevice::Append)) {
+                    touch.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+                }
+            } else {
+                bytesWritten = store();
+            }
+        }
+
+        ThumbnailCache* cache = m_cache;
+        QString appId = m_appId;
+        int generation = m_generation;
+        QMetaObject::invokeMethod(cache, [cache, appId, generation, image, meta, fromDisk, bytesWritten]() {
+            cache->onDecoded(appId, generation, image, meta, fromDisk, bytesWritten);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    // Net change in bytes on disk, sidecar included
+    qint64 store() {
+        qint64 previous = QFileInfo(m_path).size() + QFileInfo(metaPathFor(m_path)).size();
+        QSaveFile file(m_path);
+        if (!file.open(QIODevice::WriteOnly)) return 0;
+        file.write(m_data);
+        if (!file.commit()) return 0;
+        qint64 metaSize = ThumbnailCache::writeMeta(metaPathFor(m_path), m_meta);
+        return m_data.size() + metaSize - previous;
+    }
+
+    ThumbnailCache* m_cache;
+    QString m_appId;
+    QString m_path;
+    QByteArray m_data;
+    ThumbnailCache::DiskMeta m_meta;
+    QSize m_targetSize;
+    qreal m_devicePixelRatio;
+    int m_generation;
+};
+
+ThumbnailCache::ThumbnailCache(RequestScheduler* scheduler, QObject* parent)
+    : QObject(parent)
+    , m_scheduler(scheduler)
+    , m_dir(QDir(Paths::getLocalCacheDir()).filePath("thumbnails"))
+{
+    m_memory.setMaxCost(MEMORY_BUDGET_KB);
+    m_prefetched.setMaxCost(PREFETCH_BUDGET_KB);
+    m_pool.setMaxThreadCount(qMax(2, QThread::idealThreadCount() / 2));
+    QDir().mkpath(m_dir);
+
+    // Listing a full cache folder takes a while; the total is added once it is known
+    QString dir = m_dir;
+    m_pool.start([this, dir]() {
+        qint64 total = 0;
+        for (const QFileInfo& info : QDir(dir).entryInfoList({"*.jpg", "*.jpg.json"}, QDir::Files)) {
+            total += info.size();
+        }
+        QMetaObject::invokeMethod(this, [this, total]() {
+            m_diskBytes += total;
+            if (m_diskBytes > DISK_BUDGET_BYTES) trimDisk();
+        }, Qt::QueuedConnection);
+    });
+}
+
+ThumbnailCache::~ThumbnailCache() {
+    // Tasks post back to this object, let them finish first
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void ThumbnailCache::setTargetSize(const QSize& size, qreal devicePixelRatio) {
+    if (size == m_targetSize && qFuzzyCompare(devicePixelRatio, m_devicePixelRatio)) return;
+    m_targetSize = size;
+    m_devicePixelRatio = devicePixelRatio;
+    m_generation++;
+    m_memory.clear(); // scaled for the old size
+    m_prefetched.clear();
+}
+
+QPixmap ThumbnailCache::cached(const QString& appId) {
+    QPixmap* pixmap = m_memory.object(appId);
+    if (pixmap) return *pixmap;
+    // A card is showing it now: move it over to the on-screen tier
+    pixmap = m_prefetched.take(appId);
+    if (!pixmap) return QPixmap();
+    QPixmap result = *pixmap;
+    m_memory.insert(appId, pixmap, costOf(result));
+    return result;
+}
+
+bool ThumbnailCache::isCached(const QString& appId) const {
+    return m_memory.contains(appId) || m_prefetched.contains(appId);
+}
+
+QUrl ThumbnailCache::urlFor(const QString& appId) {
+    return QUrl(QString("https://cdn.akamai.steamstatic.com/steam/apps/%1/header.jpg").arg(appId));
+}
+
+void ThumbnailCache::request(const QString& appId, RequestScheduler::Priority priority) {
+    if (appId.isEmpty() || m_missing.contains(appId)) return;
+    if (m_pending.contains(appId)) {
+        // Already on its way; only ever move it up
+        if (priority < m_priorities.value(appId, RequestScheduler::Background)) {
+            m_priorities.insert(appId, priority);
+            if (m_fetches.contains(appId)) m_scheduler->setPriority(m_fetches.value(appId), priority);
+        }
+        return;
+    }
+
+    // Looking it up would promote a prefetched pixmap no card shows yet
+    if (priority >= RequestScheduler::Prefetch && isCached(appId)) return;
+    QPixmap pixmap = cached(appId);
+    if (!pixmap.isNull()) {
+        emit thumbnailReady(appId, pixmap);
+        return;
+    }
+
+    // Try the disk copy first; onDecoded falls through to the network when there is none
+    m_pending.insert(appId);
+    m_priorities.insert(appId, priority);
+    decode(appId, QByteArray(), DiskMeta());
+}
+
+void ThumbnailCache::setViewport(const QStringList& visible, const QStringList& upcoming) {
+    // Only as many upcoming ids as fit the prefetch budget, nearest first
+    QStringList ahead = upcoming;
+    if (!m_targetSize.isEmpty()) {
+        qint64 perCard = qMax<qint64>(1, qint64(m_targetSize.width() * m_devicePixelRatio)
+                                             * qint64(m_targetSize.height() * m_devicePixelRatio) * 4 / 1024);
+        ahead = ahead.mid(0, int(PREFETCH_BUDGET_KB / perCard));
+    }
+
+    QSet<QString> onScreen(visible.begin(), visible.end());
+    QSet<QString> next(ahead.begin(), ahead.end());
+    // cancel() can call back into onReplyFinished, which edits m_fetches
+    for (const QString& appId : m_fetches.keys()) {
+        RequestScheduler::Ticket ticket = m_fetches.value(appId);
+        if (onScreen.contains(appId)) {
+            m_priorities.insert(appId, RequestScheduler::Visible);
+            m_scheduler->setPriority(ticket, RequestScheduler::Visible);
+        } else if (next.contains(appId)) {
+            m_priorities.insert(appId, RequestScheduler::Prefetch);
+            m_scheduler->setPriority(ticket, RequestScheduler::Prefetch);
+        } else if (!m_scheduler->isStarted(ticket)
+                   || m_scheduler->priorityOf(ticket) >= RequestScheduler::Prefetch) {
+            // Scrolled past: let visible downloads already running finish into the cache
+            m_scheduler->cancel(ticket);
+        }
+    }
+
+    // Visible first, so their disk reads are ahead of the prefetches on the pool
+    for (const QString& appId : visible) {
+        if (cached(appId).isNull()) request(appId, RequestScheduler::Visible);
+    }
+    for (const QString& appId : ahead) {
+        if (!isCached(appId)) request(appId, RequestScheduler::Prefetch);
+    }
+}
+
+QString ThumbnailCache::pathFor(const QString& appId) const {
+    QByteArray digest = QCryptographicHash::hash(urlFor(appId).toEncoded(), QCryptographicHash::Sha1);
+    return QDir(m_dir).filePath(QString::fromLatin1(digest.toHex()) + ".jpg");
+}
+
+void ThumbnailCache::decode(const QString& appId, const QByteArray& data, const DiskMeta& meta) {
+    m_pool.start(new ThumbnailDecodeTask(this, appId, pathFor(appId), data, meta,
+                                         m_targetSize, m_devicePixelRatio, m_generation));
+}
+
+void ThumbnailCache::onDecoded(const QString& appId, int generation, const QImage& image,
+                               const DiskMeta& meta, bool fromDisk, qint64 bytesWritten) {
+    m_diskBytes += bytesWritten;
+    if (m_diskBytes > DISK_BUDGET_BYTES) trimDisk();
+
+    if (image.isNull()) {
+        // Nothing usable on disk: download it unconditionally
+        if (fromDisk) fetch(appId, DiskMeta());
+        else finishPending(appId);
+        return;
+    }
+
+    QPixmap pixmap = QPixmap::fromImage(image);
+    // Priorities only move up, so anything still at Prefetch isn't on screen
+    bool prefetch = m_priorities.value(appId, RequestScheduler::Visible) >= RequestScheduler::Prefetch;
+    if (generation == m_generation) insert(appId, pixmap, prefetch);
+    emit thumbnailReady(appId, pixmap);
+
+    if (fromDisk && QDateTime::currentSecsSinceEpoch() - meta.fetchedAt >= REVALIDATE_AFTER_SECS) {
+        // Already on screen from the disk copy, so checking it for updates can wait
+        m_priorities.insert(appId, RequestScheduler::Background);
+        fetch(appId, meta);
+        return;
+    }
+    finishPending(appId);
+}
+
+void ThumbnailCache::finishPending(const QString& appId) {
+    m_pending.remove(appId);
+    m_priorities.remove(appId);
+}
+
+void ThumbnailCache::insert(const QString& appId, const QPixmap& pixmap, bool prefetch) {
+    if (prefetch) {
+        m_prefetched.insert(appId, new QPixmap(pixmap), costOf(pixmap));
+        return;
+    }
+    m_prefetched.remove(appId);
+    m_memory.insert(appId, new QPixmap(pixmap), costOf(pixmap));
+}
+
+void ThumbnailCache::fetch(const QString& appId, const DiskMeta& meta) {
+    if (!m_scheduler) {
+        finishPending(appId);
+        return;
+    }
+
+    QNetworkRequest request(urlFor(appId));
+    if (!meta.etag.isEmpty()) request.setRawHeader("If-None-Match", meta.etag);
+    if (!meta.lastModified.isEmpty()) request.setRawHeader("If-Modified-Since", meta.lastModified);
+
+    m_pending.insert(appId);
+    RequestScheduler::Priority priority = m_priorities.value(appId, RequestScheduler::Visible);
+    m_fetches.insert(appId, m_scheduler->enqueue(request, priority, this, [this, appId](QNetworkReply* reply) {
+        onReplyFinished(appId, reply);
+    }));
+}
+
+void ThumbnailCache::onReplyFinished(const QString& appId, QNetworkReply* reply) {
+    m_fetches.remove(appId);
+    if (!reply || reply->error() == QNetworkReply::OperationCanceledError) {
+        // Cancelled as the viewport moved; asked for again when it comes back
+        finishPending(appId);
+        return;
+    }
+
+    int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (statusCode == 404) {
+        finishPending(appId);
+        m_missing.insert(appId); // not every app has a header image
+        return;
+    }
+    if (reply->error() != QNetworkReply::NoError) {
+        finishPending(appId);
+        return;
+    }
+
+    QString path = pathFor(appId);
+    DiskMeta meta;
+    meta.etag = reply->rawHeader("ETag");
+    meta.lastModified = reply->rawHeader("Last-Modified");
+    meta.fetchedAt = QDateTime::currentSecsSinceEpoch();
+
+    if (statusCode == 304) {
+        // Disk copy is still current and already on screen; only its sidecar is refreshed,
+        // on the pool like every other file access
+        finishPending(appId);
+        QString metaPath = metaPathFor(path);
+        m_pool.start([this, metaPath, meta]() {
+            DiskMeta merged = meta;
+            DiskMeta old;
+            readMeta(metaPath, old);
+            if (merged.etag.isEmpty()) merged.etag = old.etag;
+            if (merged.lastModified.isEmpty()) merged.lastModified = old.lastModified;
+            qint64 previous = QFileInfo(metaPath).size();
+            qint64 delta = writeMeta(metaPath, merged) - previous;
+            QMetaObject::invokeMethod(this, [this, delta]() { m_diskBytes += delta; }, Qt::QueuedConnection);
+        });
+        return;
+    }
+
+    QByteArray data = reply->readAll();
+    if (data.isEmpty()) {
+        finishPending(appId);
+        return;
+    }
+    // Decoded and written to disk on the pool
+    decode(appId, data, meta);
+}
+
+bool ThumbnailCache::readMeta(const QString& path, DiskMeta& meta) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    QJsonObject obj = QJsonDocument::fromJson(file.readAll()).object();
+    meta.etag = obj["etag"].toString().toLatin1();
+    meta.lastModified = obj["last_modified"].toString().toLatin1();
+    meta.fetchedAt = static_cast<qint64>(obj["fetched_at"].toDouble(0));
+    return true;
+}
+
+qint64 ThumbnailCache::writeMeta(const QString& path, const DiskMeta& meta) {
+    QJsonObject obj;
+    obj["etag"] = QString::fromLatin1(meta.etag);
+    obj["last_modified"] = QString::fromLatin1(meta.lastModified);
+    obj["fetched_at"] = static_cast<double>(meta.fetchedAt);
+
+    QByteArray data = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return QFileInfo(path).size();
+    file.write(data);
+    return file.commit() ? data.size() : QFileInfo(path).size();
+}
+
+void ThumbnailCache::trimDisk() {
+    if (m_trimming) return;
+    m_trimming = true;
+
+    // Oldest first; trim to 80% so this doesn't run again on the next download.
+    // Listing and deleting run on the pool; the bytes freed come back here.
+    qint64 excess = m_diskBytes - DISK_BUDGET_BYTES * 8 / 10;
+    QString dir = m_dir;
+    m_pool.start([this, dir, excess]() {
+        qint64 removed = 0;
+        QFileInfoList files = QDir(dir).entryInfoList({"*.jpg"}, QDir::Files, QDir::Time | QDir::Reversed);
+        for (const QFileInfo& info : files) {
+            if (removed >= excess) break;
+            if (QFile::remove(info.filePath())) {
+                QString metaPath = metaPathFor(info.filePath());
+                qint64 metaSize = QFileInfo(metaPath).size();
+                if (QFile::remove(metaPath)) removed += metaSize;
+                removed += info.size();
+            }
+        }
+        QMetaObject::invokeMethod(this, [this, removed]() {
+            m_diskBytes -= removed;
+            m_trimming = false;
+        }, Qt::QueuedConnection);
+    });
+}
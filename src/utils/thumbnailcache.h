@@ -0,0 +1,96 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QUrl>
+#include "requestscheduler.h"
+
+class QNetworkReply;
+class ThumbnailDecodeTask;
+
+// Two-tier store for Steam header images.
+// Decoded pixmaps, scaled to the card size, live in a byte-budgeted LRU, with
+// prefetched ones held in a separate, smaller LRU until a card shows them;
+// the downloaded files live under <cache>/thumbnails named by the SHA-1 of
+// their URL, each with a small JSON sidecar holding the ETag/Last-Modified
+// used to revalidate it once it is older than a week.
+// File IO, JPEG decoding and scaling run on a private thread pool; only the
+// finished image comes back to the GUI thread to become a QPixmap.
+// Downloads go through the RequestScheduler at the priority they were
+// requested with; setViewport() reorders them as the grid scrolls.
+class ThumbnailCache : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ThumbnailCache(RequestScheduler* scheduler, QObject* parent = nullptr);
+    ~ThumbnailCache();
+
+    // Card area in logical pixels; images are scaled to size * dpr once, off the GUI thread
+    void setTargetSize(const QSize& size, qreal devicePixelRatio);
+
+    // Memory tier only; null when the thumbnail is not decoded yet. For binding
+    // cards: a prefetched pixmap moves to the on-screen LRU when looked up.
+    QPixmap cached(const QString& appId);
+
+    // Disk copy if there is one, otherwise a CDN download; thumbnailReady follows
+    void request(const QString& appId, RequestScheduler::Priority priority = RequestScheduler::Visible);
+    // Requests the visible ids, then as many upcoming ones (nearest first) as
+    // the prefetch LRU holds, at Prefetch priority.
+    // Any other download that hasn't started is dropped, as are running prefetches.
+    void setViewport(const QStringList& visible, const QStringList& upcoming = QStringList());
+
+    static QUrl urlFor(const QString& appId);
+
+signals:
+    void thumbnailReady(const QString& appId, const QPixmap& pixmap);
+
+private:
+    friend class ThumbnailDecodeTask;
+
+    struct DiskMeta {
+        QByteArray etag;
+        QByteArray lastModified;
+        qint64 fetchedAt = 0;
+    };
+
+    QString pathFor(const QString& appId) const;
+    void decode(const QString& appId, const QByteArray& data, const DiskMeta& meta);
+    void onDecoded(const QString& appId, int generation, const QImage& image,
+                   const DiskMeta& meta, bool fromDisk, qint64 bytesWritten);
+    bool isCached(const QString& appId) const;
+    void insert(const QString& appId, const QPixmap& pixmap, bool prefetch);
+    void finishPending(const QString& appId);
+    void fetch(const QString& appId, const DiskMeta& meta);
+    void onReplyFinished(const QString& appId, QNetworkReply* reply);
+    void trimDisk();
+
+    static bool readMeta(const QString& path, DiskMeta& meta);
+    // Size of the sidecar on disk afterwards
+    static qint64 writeMeta(const QString& path, const DiskMeta& meta);
+
+    RequestScheduler* m_scheduler;
+    QThreadPool m_pool;
+    QCache<QString, QPixmap> m_memory;
+    QCache<QString, QPixmap> m_prefetched;  // not shown by any card yet
+    QSet<QString> m_pending;
+    QSet<QString> m_missing;
+    QHash<QString, RequestScheduler::Priority> m_priorities;  // pending ids
+    QHash<QString, RequestScheduler::Ticket> m_fetches;       // ids with a download queued or running
+    QString m_dir;
+    QSize m_targetSize;
+    qreal m_devicePixelRatio = 1.0;
+    int m_generation = 0;
+    qint64 m_diskBytes = 0;
+    bool m_trimming = false;  // a trim is running on the pool
+};
+
+#endif // THUMBNAILCACHE_H
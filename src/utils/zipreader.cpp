@@ -0,0 +1,767 @@
+#include "zipreader.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStringList>
+#include <QMutex>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <QtEndian>
+#include <zlib.h>
+
+namespace {
+    const quint32 LOCAL_HEADER_SIG = 0x04034b50;
+    const quint32 CENTRAL_HEADER_SIG = 0x02014b50;
+    const quint32 EOCD_SIG = 0x06054b50;
+    const quint32 EOCD64_LOCATOR_SIG = 0x07064b50;
+    const quint32 EOCD64_SIG = 0x06064b50;
+    const int LOCAL_HEADER_SIZE = 30;
+    const int CENTRAL_HEADER_SIZE = 46;
+    const int EOCD_SIZE = 22;
+    const int EOCD64_LOCATOR_SIZE = 20;
+    const int EOCD64_SIZE = 56;
+    const int MAX_COMMENT = 0xFFFF;
+    const qint64 CHUNK_SIZE = 64 * 1024;
+    // Deflate can't expand data by more than about 1032:1, so anything past
+    // that is a malformed or hostile stream
+    const qint64 MAX_DEFLATE_RATIO = 1032;
+
+    inline quint16 u16(const char* p) { return qFromLittleEndian<quint16>(p); }
+    inline quint32 u32(const char* p) { return qFromLittleEndian<quint32>(p); }
+    inline quint64 u64(const char* p) { return qFromLittleEndian<quint64>(p); }
+
+    // Whether Windows would store a path component under this exact name.
+    // ':' covers drive letters as well as NTFS alternate data streams
+    // (file.txt:stream); device names are reserved with any extension
+    // (NUL.txt); trailing dots and spaces are silently stripped, so
+    // "file." would alias "file".
+    bool isPortableComponent(const QString& part) {
+        static const QStringList reserved = {
+            "CON", "PRN", "AUX", "NUL",
+            "COM1", "COM2", "COM3", "COM4", "COM5", "COM6", "COM7", "COM8", "COM9",
+            "LPT1", "LPT2", "LPT3", "LPT4", "LPT5", "LPT6", "LPT7", "LPT8", "LPT9"
+        };
+        for (const QChar& c : part) {
+            if (c.unicode() < 0x20 || QStringLiteral(":<>\"|?*").contains(c)) return false;
+        }
+        if (part.endsWith('.') || part.endsWith(' ')) return false;
+        QString stem = part.section('.', 0, 0).trimmed().toUpper();
+        return !reserved.contains(stem);
+    }
+}
+
+bool ZipReader::open(const QString& path) {
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return fail(QString("Failed to open %1: %2").arg(path, m_file.errorString()));
+    }
+    if (!readCentralDirectory()) {
+        m_file.close();
+        return false;
+    }
+    return true;
+}
+
+void ZipReader::close() {
+    m_file.close();
+    m_entries.clear();
+    m_error.clear();
+}
+
+bool ZipReader::fail(const QString& message) {
+    m_error = message;
+    return false;
+}
+
+qint64 ZipReader::totalUncompressedSize() const {
+    qint64 total = 0;
+    for (const Entry& entry : m_entries) total += entry.uncompressedSize;
+    return total;
+}
+
+bool ZipReader::readCentralDirectory() {
+    const qint64 size = m_file.size();
+    if (size < EOCD_SIZE) return fail("Not a ZIP archive (file too small)");
+
+    // The end-of-central-directory record sits behind an optional comment of up to 64 KB
+    qint64 tailSize = qMin<qint64>(size, EOCD_SIZE + MAX_COMMENT);
+    m_file.seek(size - tailSize);
+    QByteArray tail = m_file.read(tailSize);
+    int eocd = -1;
+    for (int i = tail.size() - EOCD_SIZE; i >= 0; --i) {
+        if (u32(tail.constData() + i) == EOCD_SIG) { eocd = i; break; }
+    }
+    if (eocd < 0) return fail("Not a ZIP archive (no end of central directory)");
+
+    const char* e = tail.constData() + eocd;
+    quint64 entryCount = u16(e + 10);
+    quint64 cdSize = u32(e + 12);
+    quint64 cdOffset = u32(e + 16);
+
+    // ZIP64 archives keep the real values in a second record found through a locator
+    if (entryCount == 0xFFFF || cdSize == 0xFFFFFFFF || cdOffset == 0xFFFFFFFF) {
+        if (eocd < EOCD64_LOCATOR_SIZE) return fail("Corrupt ZIP64 archive (missing locator)");
+        const char* loc = e - EOCD64_LOCATOR_SIZE;
+        if (u32(loc) != EOCD64_LOCATOR_SIG) return fail("Corrupt ZIP64 archive (missing locator)");
+        m_file.seek(static_cast<qint64>(u64(loc + 8)));
+        QByteArray record = m_file.read(EOCD64_SIZE);
+        if (record.size() != EOCD64_SIZE || u32(record.constData()) != EOCD64_SIG) {
+            return fail("Corrupt ZIP64 archive (bad end of central directory)");
+        }
+        entryCount = u64(record.constData() + 32);
+        cdSize = u64(record.constData() + 40);
+        cdOffset = u64(record.constData() + 48);
+    }
+
+    if (cdOffset + cdSize > static_cast<quint64>(size)) return fail("Corrupt ZIP archive (central directory out of range)");
+    if (entryCount > cdSize / CENTRAL_HEADER_SIZE) return fail("Corrupt ZIP archive (bad entry count)");
+
+    m_file.seek(static_cast<qint64>(cdOffset));
+    QByteArray cd = m_file.read(static_cast<qint64>(cdSize));
+    if (cd.size() != static_cast<int>(cdSize)) return fail("Corrupt ZIP archive (truncated central directory)");
+
+    QString error;
+    if (!parseCentralDirectory(cd, m_entries, error)) return fail(error);
+    if (static_cast<quint64>(m_entries.size()) != entryCount) return fail("Corrupt ZIP archive (bad entry count)");
+    return true;
+}
+
+bool ZipReader::parseCentralDirectory(const QByteArray& cd, QVector<Entry>& entries, QString& error) {
+    int pos = 0;
+    while (pos + 4 <= cd.size() && u32(cd.constData() + pos) == CENTRAL_HEADER_SIG) {
+        if (pos + CENTRAL_HEADER_SIZE > cd.size()) {
+            error = "Corrupt ZIP archive (truncated entry)";
+            return false;
+        }
+        const char* h = cd.constData() + pos;
+        quint16 madeBy = u16(h + 4);
+        quint16 nameLen = u16(h + 28);
+        quint16 extraLen = u16(h + 30);
+        quint16 commentLen = u16(h + 32);
+        quint32 externalAttrs = u32(h + 38);
+        if (pos + CENTRAL_HEADER_SIZE + nameLen + extraLen + commentLen > cd.size()) {
+            error = "Corrupt ZIP archive (truncated entry)";
+            return false;
+        }
+
+        Entry entry;
+        entry.flags = u16(h + 8);
+        entry.method = u16(h + 10);
+        entry.crc = u32(h + 16);
+        quint64 compressed = u32(h + 20);
+        quint64 uncompressed = u32(h + 24);
+        quint64 offset = u32(h + 42);
+
+        QByteArray rawName(h + CENTRAL_HEADER_SIZE, nameLen);
+        // Bit 11 marks UTF-8 names; older tools use the DOS code page, close enough to Latin-1
+        entry.name = (entry.flags & 0x0800) ? QString::fromUtf8(rawName) : QString::fromLatin1(rawName);
+
+        // ZIP64 extra field: only the values that overflowed are present, in this order
+        const char* extra = h + CENTRAL_HEADER_SIZE + nameLen;
+        const char* extraEnd = extra + extraLen;
+        while (extra + 4 <= extraEnd) {
+            quint16 id = u16(extra);
+            quint16 len = u16(extra + 2);
+            const char* field = extra + 4;
+            const char* fieldEnd = qMin(field + len, extraEnd);
+            if (id == 0x0001) {
+                if (uncompressed == 0xFFFFFFFF && field + 8 <= fieldEnd) { uncompressed = u64(field); field += 8; }
+                if (compressed == 0xFFFFFFFF && field + 8 <= fieldEnd) { compressed = u64(field); field += 8; }
+                if (offset == 0xFFFFFFFF && field + 8 <= fieldEnd) { offset = u64(field); field += 8; }
+            }
+            extra += 4 + len;
+        }
+
+        entry.compressedSize = static_cast<qint64>(compressed);
+        entry.uncompressedSize = static_cast<qint64>(uncompressed);
+        entry.localHeaderOffset = static_cast<qint64>(offset);
+        entry.isDir = entry.name.endsWith('/') || entry.name.endsWith('\\');
+        // Unix hosts keep the file mode in the upper half of the external attributes
+        entry.isSymlink = (madeBy >> 8) == 3 && ((externalAttrs >> 16) & 0170000) == 0120000;
+        entries.append(entry);
+
+        pos += CENTRAL_HEADER_SIZE + nameLen + extraLen + commentLen;
+    }
+    return true;
+}
+
+qint64 ZipReader::dataOffset(QFile& archive, const Entry& entry) {
+    // The local header repeats the name but may carry a different extra field
+    if (!archive.seek(entry.localHeaderOffset)) return -1;
+    QByteArray header = archive.read(LOCAL_HEADER_SIZE);
+    if (header.size() != LOCAL_HEADER_SIZE || u32(header.constData()) != LOCAL_HEADER_SIG) return -1;
+    qint64 offset = entry.localHeaderOffset + LOCAL_HEADER_SIZE
+                  + u16(header.constData() + 26) + u16(header.constData() + 28);
+    if (offset + entry.compressedSize > archive.size()) return -1;
+    return offset;
+}
+
+bool ZipReader::sanitizeName(const QString& name, QString& relative) {
+    QString path = name;
+    path.replace('\\', '/');
+    if (path.startsWith('/')) return false;
+
+    QStringList parts;
+    for (const QString& part : path.split('/', Qt::SkipEmptyParts)) {
+        if (part == ".") continue;
+        if (part == "..") return false;
+        if (!isPortableComponent(part)) return false;
+        parts.append(part);
+    }
+    if (parts.isEmpty()) return false;
+    relative = parts.join('/');
+    return true;
+}
+
+bool ZipReader::inflateEntry(QIODevice& in, const Entry& entry, QIODevice& out, QString& error) {
+    if (entry.flags & 0x0001) {
+        error = QString("%1 is encrypted").arg(entry.name);
+        return false;
+    }
+    if (entry.method != 0 && entry.method != 8) {
+        error = QString("%1 uses unsupported compression method %2").arg(entry.name).arg(entry.method);
+        return false;
+    }
+
+    QByteArray input;
+    QByteArray output(CHUNK_SIZE, Qt::Uninitialized);
+    qint64 remaining = entry.compressedSize;
+    qint64 written = 0;
+    uLong crc = crc32(0L, Z_NULL, 0);
+
+    // Nothing past the declared size reaches the disk, so a bomb stops at its first extra chunk
+    bool overrun = false;
+    auto emitBytes = [&](const char* data, qint64 size) {
+        if (written + size > entry.uncompressedSize) {
+            overrun = true;
+            return false;
+        }
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(data), static_cast<uInt>(size));
+        written += size;
+        return out.write(data, size) == size;
+    };
+    auto writeError = [&]() {
+        return overrun ? QString("%1 inflates past its declared size").arg(entry.name)
+                       : QString("Failed to write %1").arg(entry.name);
+    };
+
+    if (entry.method == 0) {
+        while (remaining > 0) {
+            input = in.read(qMin(remaining, CHUNK_SIZE));
+            if (input.isEmpty()) { error = QString("%1 is truncated").arg(entry.name); return false; }
+            remaining -= input.size();
+            if (!emitBytes(input.constData(), input.size())) {
+                error = writeError();
+                return false;
+            }
+        }
+    } else {
+        z_stream zs = {};
+        if (inflateInit2(&zs, -MAX_WBITS) != Z_OK) { // raw deflate, no zlib header
+            error = "Failed to initialise zlib";
+            return false;
+        }
+        int ret = Z_OK;
+        while (ret != Z_STREAM_END) {
+            if (zs.avail_in == 0) {
+                if (remaining <= 0) break;
+                input = in.read(qMin(remaining, CHUNK_SIZE));
+                if (input.isEmpty()) break;
+                remaining -= input.size();
+                zs.next_in = reinterpret_cast<Bytef*>(input.data());
+                zs.avail_in = static_cast<uInt>(input.size());
+            }
+            zs.next_out = reinterpret_cast<Bytef*>(output.data());
+            zs.avail_out = static_cast<uInt>(output.size());
+            ret = inflate(&zs, Z_NO_FLUSH);
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) break;
+            qint64 produced = output.size() - zs.avail_out;
+            if (produced > 0 && !emitBytes(output.constData(), produced)) {
+                inflateEnd(&zs);
+                error = writeError();
+                return false;
+            }
+        }
+        inflateEnd(&zs);
+        if (ret != Z_STREAM_END) {
+            error = QString("%1 is corrupt or truncated").arg(entry.name);
+            return false;
+        }
+    }
+
+    if (written != entry.uncompressedSize || crc != entry.crc) {
+        error = QString("%1 failed the integrity check").arg(entry.name);
+        return false;
+    }
+    return true;
+}
+
+bool ZipReader::extractFile(QFile& archive, const Entry& entry, const QString& target, QString& error) {
+    qint64 offset = dataOffset(archive, entry);
+    if (offset < 0 || !archive.seek(offset)) {
+        error = QString("Corrupt ZIP archive (bad header for %1)").arg(entry.name);
+        return false;
+    }
+
+    QSaveFile out(target);
+    if (!out.open(QIODevice::WriteOnly)) {
+        error = QString("Failed to open %1: %2").arg(target, out.errorString());
+        return false;
+    }
+    if (!inflateEntry(archive, entry, out, error)) return false;
+    if (!out.commit()) {
+        error = QString("Failed to write %1: %2").arg(target, out.errorString());
+        return false;
+    }
+    return true;
+}
+
+bool ZipReader::extract(const Entry& entry, const QString& destDir) {
+    QString relative;
+    if (!sanitizeName(entry.name, relative)) {
+        return fail(QString("Refusing to extract %1: path leaves the target folder").arg(entry.name));
+    }
+    QString target = QDir(destDir).filePath(relative);
+
+    if (entry.isDir) {
+        if (!QDir().mkpath(target)) return fail(QString("Failed to create folder %1").arg(target));
+        return true;
+    }
+    if (entry.isSymlink) return true; // never follow or create links from an archive
+
+    if (!QDir().mkpath(QFileInfo(target).absolutePath())) {
+        return fail(QString("Failed to create folder for %1").arg(target));
+    }
+    QString error;
+    if (!extractFile(m_file, entry, target, error)) return fail(error);
+    return true;
+}
+
+bool ZipReader::extractAll(const QString& destDir,
+                           const std::function<void(int, int, const QString&)>& onEntry) {
+    // Resolve every target (and create the folders) up front so the workers only write files
+    QVector<QString> targets(m_entries.size());
+    QString relative;
+    for (int i = 0; i < m_entries.size(); ++i) {
+        const Entry& entry = m_entries[i];
+        if (!sanitizeName(entry.name, relative)) {
+            return fail(QString("Refusing to extract %1: path leaves the target folder").arg(entry.name));
+        }
+        targets[i] = QDir(destDir).filePath(relative);
+    }
+    if (!QDir().mkpath(destDir)) return fail(QString("Failed to create folder %1").arg(destDir));
+    for (int i = 0; i < m_entries.size(); ++i) {
+        const Entry& entry = m_entries[i];
+        if (entry.isSymlink) continue;
+        QString folder = entry.isDir ? targets[i] : QFileInfo(targets[i]).absolutePath();
+        if (!QDir().mkpath(folder)) return fail(QString("Failed to create folder %1").arg(folder));
+    }
+
+    if (m_maxThreads <= 1) {
+        for (int i = 0; i < m_entries.size(); ++i) {
+            if (onEntry) onEntry(i, m_entries.size(), m_entries[i].name);
+            if (!extract(m_entries[i], destDir)) return false;
+        }
+        return true;
+    }
+
+    // Entries are inflated on a pool, each through its own handle on the archive.
+    // Dispatch waits while the entries in flight add up to more than the byte
+    // budget, so a few huge files don't all hit the disk at once; an entry
+    // bigger than the whole budget runs on its own.
+    QThreadPool pool;
+    pool.setMaxThreadCount(m_maxThreads);
+    QMutex mutex;
+    QWaitCondition slotFreed;
+    qint64 inFlight = 0;
+    QString firstError;
+    const QString archivePath = m_file.fileName();
+
+    // A name repeated in the archive would race with itself; the last copy wins
+    QHash<QString, int> lastIndex;
+    for (int i = 0; i < m_entries.size(); ++i) lastIndex.insert(targets[i], i);
+
+    for (int i = 0; i < m_entries.size(); ++i) {
+        const Entry& entry = m_entries[i];
+        if (onEntry) onEntry(i, m_entries.size(), entry.name);
+        if (entry.isDir || entry.isSymlink || lastIndex.value(targets[i]) != i) continue;
+
+        qint64 cost = qBound<qint64>(1, entry.uncompressedSize, m_maxInFlightBytes);
+        {
+            QMutexLocker lock(&mutex);
+            while (firstError.isEmpty() && inFlight > 0 && inFlight + cost > m_maxInFlightBytes) {
+                slotFreed.wait(&mutex);
+            }
+            if (!firstError.isEmpty()) break;
+            inFlight += cost;
+        }
+
+        QString target = targets[i];
+        pool.start([&, entry, target, cost]() {
+            QString error;
+            QFile archive(archivePath);
+            if (!archive.open(QIODevice::ReadOnly)) {
+                error = QString("Failed to open %1: %2").arg(archivePath, archive.errorString());
+            } else {
+                extractFile(archive, entry, target, error);
+            }
+
+            QMutexLocker lock(&mutex);
+            if (!error.isEmpty() && firstError.isEmpty()) firstError = error;
+            inFlight -= cost;
+            slotFreed.wakeAll();
+        });
+    }
+    pool.waitForDone();
+
+    if (!firstError.isEmpty()) return fail(firstError);
+    return true;
+}
+
+// ---- Streaming extraction ----
+
+struct ZipStreamExtractor::Current {
+    explicit Current(const QString& path) : file(path) {}
+
+    QString name;
+    QString relative;
+    quint16 flags = 0;
+    quint16 method = 0;
+    quint32 crc = 0;
+    qint64 compressedSize = 0;
+    qint64 uncompressedSize = 0;
+    bool zip64 = false;
+    QSaveFile file;
+    z_stream zs = {};
+    bool inflating = false;
+    uLong runningCrc = 0;
+    qint64 consumed = 0;
+    qint64 written = 0;
+};
+
+ZipStreamExtractor::ZipStreamExtractor(const QString& destDir)
+    : m_destDir(QDir::cleanPath(QDir(destDir).absolutePath()))
+    , m_stagingDir(m_destDir + ".fix-staging")
+    , m_backupDir(m_destDir + ".fix-replaced")
+{
+    // Left behind by an attempt that was killed halfway
+    QDir(m_stagingDir).removeRecursively();
+    QDir(m_backupDir).removeRecursively();
+}
+
+ZipStreamExtractor::~ZipStreamExtractor() {
+    resetEntry();
+    QDir(m_stagingDir).removeRecursively();
+}
+
+bool ZipStreamExtractor::fail(const QString& message) {
+    resetEntry();
+    m_state = State::Failed;
+    m_error = message;
+    return false;
+}
+
+void ZipStreamExtractor::resetEntry() {
+    if (!m_current) return;
+    if (m_current->inflating) inflateEnd(&m_current->zs);
+    delete m_current; // an uncommitted QSaveFile leaves the target untouched
+    m_current = nullptr;
+}
+
+bool ZipStreamExtractor::write(const QByteArray& data) {
+    if (m_state == State::Failed) return false;
+    if (m_state == State::CentralDirectory) {
+        m_centralDirectory.append(data);
+        return true;
+    }
+
+    m_buffer.append(data);
+    int pos = 0;
+    bool progress = true;
+    while (progress && pos < m_buffer.size()) {
+        int before = pos;
+        State state = m_state;
+        switch (m_state) {
+        case State::Header:
+            if (!parseHeader(pos)) return false;
+            break;
+        case State::Data:
+            if (!consumeData(pos)) return false;
+            break;
+        case State::Descriptor:
+            if (!parseDescriptor(pos)) return false;
+            break;
+        case State::CentralDirectory:
+            m_centralDirectory.append(m_buffer.mid(pos));
+            pos = m_buffer.size();
+            break;
+        case State::Failed:
+            return false;
+        }
+        progress = pos != before || m_state != state;
+    }
+    m_buffer.remove(0, pos);
+    return true;
+}
+
+bool ZipStreamExtractor::parseHeader(int& pos) {
+    if (m_buffer.size() - pos < 4) return true;
+    const char* h = m_buffer.constData() + pos;
+    quint32 sig = u32(h);
+    if (sig == CENTRAL_HEADER_SIG || sig == EOCD_SIG) {
+        m_state = State::CentralDirectory;
+        return true;
+    }
+    if (sig != LOCAL_HEADER_SIG) return fail("Not a ZIP archive (unexpected data between entries)");
+    if (m_buffer.size() - pos < LOCAL_HEADER_SIZE) return true;
+
+    quint16 nameLen = u16(h + 26);
+    quint16 extraLen = u16(h + 28);
+    if (m_buffer.size() - pos < LOCAL_HEADER_SIZE + nameLen + extraLen) return true;
+
+    quint16 flags = u16(h + 6);
+    quint16 method = u16(h + 8);
+    QByteArray rawName(h + LOCAL_HEADER_SIZE, nameLen);
+    QString name = (flags & 0x0800) ? QString::fromUtf8(rawName) : QString::fromLatin1(rawName);
+
+    QString relative;
+    if (!ZipReader::sanitizeName(name, relative)) {
+        return fail(QString("Refusing to extract %1: path leaves the target folder").arg(name));
+    }
+    if (flags & 0x0001) return fail(QString("%1 is encrypted").arg(name));
+    if (method != 0 && method != 8) {
+        return fail(QString("%1 uses unsupported compression method %2").arg(name).arg(method));
+    }
+
+    quint64 compressed = u32(h + 18);
+    quint64 uncompressed = u32(h + 22);
+    bool zip64 = false;
+    const char* extra = h + LOCAL_HEADER_SIZE + nameLen;
+    const char* extraEnd = extra + extraLen;
+    while (extra + 4 <= extraEnd) {
+        quint16 id = u16(extra);
+        quint16 len = u16(extra + 2);
+        // Unlike the central directory, a local ZIP64 field carries both sizes
+        if (id == 0x0001 && len >= 16 && extra + 4 + 16 <= extraEnd) {
+            uncompressed = u64(extra + 4);
+            compressed = u64(extra + 12);
+            zip64 = true;
+        }
+        extra += 4 + len;
+    }
+    pos += LOCAL_HEADER_SIZE + nameLen + extraLen;
+
+    QString target = QDir(m_stagingDir).filePath(relative);
+    if (name.endsWith('/') || name.endsWith('\\')) {
+        if (!QDir().mkpath(target)) return fail(QString("Failed to create folder %1").arg(target));
+        return true; // no data follows a directory entry
+    }
+
+    bool sizeLater = flags & 0x0008;
+    if (sizeLater && method == 0) {
+        return fail(QString("%1 is stored without a size and can't be streamed").arg(name));
+    }
+    if (!QDir().mkpath(QFileInfo(target).absolutePath())) {
+        return fail(QString("Failed to create folder for %1").arg(target));
+    }
+
+    m_current = new Current(target);
+    m_current->name = name;
+    m_current->relative = relative;
+    m_current->flags = flags;
+    m_current->method = method;
+    m_current->crc = u32(h + 14);
+    m_current->compressedSize = static_cast<qint64>(compressed);
+    m_current->uncompressedSize = static_cast<qint64>(uncompressed);
+    m_current->zip64 = zip64;
+    m_current->runningCrc = crc32(0L, Z_NULL, 0);
+    if (!m_current->file.open(QIODevice::WriteOnly)) {
+        return fail(QString("Failed to open %1: %2").arg(target, m_current->file.errorString()));
+    }
+    if (method == 8) {
+        if (inflateInit2(&m_current->zs, -MAX_WBITS) != Z_OK) return fail("Failed to initialise zlib");
+        m_current->inflating = true;
+    }
+
+    if (m_onEntry) m_onEntry(name);
+    m_state = State::Data;
+    if (method == 0 && compressed == 0) return finishEntry(m_current->crc, 0, 0);
+    return true;
+}
+
+bool ZipStreamExtractor::consumeData(int& pos) {
+    Current* c = m_current;
+    auto emitBytes = [c](const char* data, qint64 size) {
+        c->runningCrc = crc32(c->runningCrc, reinterpret_cast<const Bytef*>(data), static_cast<uInt>(size));
+        c->written += size;
+        return c->file.write(data, size) == size;
+    };
+
+    if (c->method == 0) {
+        qint64 take = qMin<qint64>(c->compressedSize - c->consumed, m_buffer.size() - pos);
+        if (take > 0 && !emitBytes(m_buffer.constData() + pos, take)) {
+            return fail(QString("Failed to write %1").arg(c->name));
+        }
+        pos += static_cast<int>(take);
+        c->consumed += take;
+        if (c->consumed < c->compressedSize) return true;
+        return finishEntry(c->crc, c->compressedSize, c->uncompressedSize);
+    }
+
+    // Deflate marks its own end, which is what makes bit-3 entries streamable
+    QByteArray output(CHUNK_SIZE, Qt::Uninitialized);
+    c->zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(m_buffer.constData() + pos));
+    c->zs.avail_in = static_cast<uInt>(m_buffer.size() - pos);
+    int ret = Z_OK;
+    while (ret != Z_STREAM_END && c->zs.avail_in > 0) {
+        c->zs.next_out = reinterpret_cast<Bytef*>(output.data());
+        c->zs.avail_out = static_cast<uInt>(output.size());
+        ret = inflate(&c->zs, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+            return fail(QString("%1 is corrupt").arg(c->name));
+        }
+        qint64 produced = output.size() - c->zs.avail_out;
+        // The declared size is a hard limit; bit-3 entries only declare it afterwards
+        qint64 in = c->consumed + (m_buffer.size() - pos) - static_cast<qint64>(c->zs.avail_in);
+        qint64 limit = (c->flags & 0x0008) ? in * MAX_DEFLATE_RATIO + CHUNK_SIZE : c->uncompressedSize;
+        if (c->written + produced > limit) {
+            return fail(QString("%1 inflates past its declared size").arg(c->name));
+        }
+        if (produced > 0 && !emitBytes(output.constData(), produced)) {
+            return fail(QString("Failed to write %1").arg(c->name));
+        }
+        if (ret == Z_BUF_ERROR && produced == 0) break;
+    }
+    int used = (m_buffer.size() - pos) - static_cast<int>(c->zs.avail_in);
+    pos += used;
+    c->consumed += used;
+    if (ret != Z_STREAM_END) return true;
+
+    if (c->flags & 0x0008) {
+        m_state = State::Descriptor;
+        return true;
+    }
+    return finishEntry(c->crc, c->compressedSize, c->uncompressedSize);
+}
+
+bool ZipStreamExtractor::parseDescriptor(int& pos) {
+    // [signature] crc32, compressed size, uncompressed size (8 bytes each for ZIP64)
+    const int sizeBytes = m_current->zip64 ? 8 : 4;
+    int available = m_buffer.size() - pos;
+    if (available < 4) return true;
+    const char* d = m_buffer.constData() + pos;
+    int skip = u32(d) == 0x08074b50 ? 4 : 0;
+    int needed = skip + 4 + 2 * sizeBytes;
+    if (available < needed) return true;
+
+    d += skip;
+    quint32 crc = u32(d);
+    qint64 compressed = sizeBytes == 8 ? static_cast<qint64>(u64(d + 4)) : u32(d + 4);
+    qint64 uncompressed = sizeBytes == 8 ? static_cast<qint64>(u64(d + 12)) : u32(d + 8);
+    pos += needed;
+    return finishEntry(crc, compressed, uncompressed);
+}
+
+bool ZipStreamExtractor::finishEntry(quint32 crc, qint64 compressedSize, qint64 uncompressedSize) {
+    Current* c = m_current;
+    if (c->consumed != compressedSize || c->written != uncompressedSize || c->runningCrc != crc) {
+        return fail(QString("%1 failed the integrity check").arg(c->name));
+    }
+    if (!c->file.commit()) {
+        return fail(QString("Failed to write %1: %2").arg(c->file.fileName(), c->file.errorString()));
+    }
+
+    Done done;
+    done.path = c->file.fileName();
+    done.relative = c->relative;
+    done.crc = crc;
+    done.uncompressedSize = uncompressedSize;
+    m_done.insert(c->name, done);
+    resetEntry();
+    m_state = State::Header;
+    return true;
+}
+
+bool ZipStreamExtractor::finish() {
+    if (m_state == State::Failed) return false;
+    if (m_state != State::CentralDirectory) return fail("ZIP archive is truncated");
+
+    QVector<ZipReader::Entry> entries;
+    QString error;
+    if (!ZipReader::parseCentralDirectory(m_centralDirectory, entries, error)) return fail(error);
+
+    // Only what the central directory lists is part of the archive; anything
+    // else stays in the staging folder and is deleted with it
+    QHash<QString, Done> extracted = m_done;
+    QStringList folders;
+    QVector<Done> files;
+    for (const ZipReader::Entry& entry : entries) {
+        if (entry.isDir) {
+            QString relative;
+            if (!ZipReader::sanitizeName(entry.name, relative)) {
+                return fail(QString("Refusing to extract %1: path leaves the target folder").arg(entry.name));
+            }
+            folders.append(relative);
+            continue;
+        }
+        auto it = extracted.find(entry.name);
+        if (it == extracted.end()) return fail(QString("%1 is listed but was not in the stream").arg(entry.name));
+        if (!entry.isSymlink) { // never create links from an archive
+            if (it->crc != entry.crc || it->uncompressedSize != entry.uncompressedSize) {
+                return fail(QString("%1 does not match the central directory").arg(entry.name));
+            }
+            files.append(*it);
+        }
+        extracted.erase(it);
+    }
+    return install(folders, files);
+}
+
+bool ZipStreamExtractor::install(const QStringList& folders, const QVector<Done>& files) {
+    QDir dest(m_destDir);
+    for (const QString& folder : folders) {
+        if (!dest.mkpath(folder)) return fail(QString("Failed to create folder %1").arg(dest.filePath(folder)));
+    }
+
+    // Files being replaced are parked in the backup folder until every
+    // staged file has moved, so a failure halfway can put them back
+    struct Moved {
+        QString target;
+        QString backup;
+    };
+    QVector<Moved> moved;
+    QString error;
+    for (const Done& file : files) {
+        Moved move;
+        move.target = dest.filePath(file.relative);
+        if (!QDir().mkpath(QFileInfo(move.target).absolutePath())) {
+            error = QString("Failed to create folder for %1").arg(move.target);
+            break;
+        }
+        if (QFileInfo::exists(move.target)) {
+            move.backup = QDir(m_backupDir).filePath(file.relative);
+            if (!QDir().mkpath(QFileInfo(move.backup).absolutePath()) || !QFile::rename(move.target, move.backup)) {
+                error = QString("Failed to replace %1").arg(move.target);
+                break;
+            }
+        }
+        if (!QFile::rename(file.path, move.target)) {
+            if (!move.backup.isEmpty()) QFile::rename(move.backup, move.target);
+            error = QString("Failed to move %1 into place").arg(move.target);
+            break;
+        }
+        moved.append(move);
+    }
+
+    if (!error.isEmpty()) {
+        for (int i = moved.size() - 1; i >= 0; --i) {
+            QFile::remove(moved[i].target);
+            if (!moved[i].backup.isEmpty()) QFile::rename(moved[i].backup, moved[i].target);
+        }
+    }
+    QDir(m_backupDir).removeRecursively();
+    if (!error.isEmpty()) return fail(error);
+    QDir(m_stagingDir).removeRecursively();
+    return true;
+}
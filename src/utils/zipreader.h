@@ -0,0 +1,137 @@
+#ifndef ZIPREADER_H
+#define ZIPREADER_H
+
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QVector>
+#include <functional>
+
+class QIODevice;
+
+// In-process ZIP extraction. The central directory is parsed up front and
+// each entry is inflated with zlib straight into its destination file one
+// chunk at a time, so memory use doesn't depend on the archive size.
+// Stored and deflated entries are supported, including ZIP64 sizes;
+// encrypted entries are refused.
+class ZipReader {
+public:
+    struct Entry {
+        QString name;            // as stored in the archive
+        quint16 flags = 0;
+        quint16 method = 0;      // 0 stored, 8 deflated
+        quint32 crc = 0;
+        qint64 compressedSize = 0;
+        qint64 uncompressedSize = 0;
+        qint64 localHeaderOffset = 0;
+        bool isDir = false;
+        bool isSymlink = false;
+    };
+
+    ZipReader() = default;
+
+    bool open(const QString& path);
+    void close();
+    QString errorString() const { return m_error; }
+
+    const QVector<Entry>& entries() const { return m_entries; }
+    qint64 totalUncompressedSize() const;
+
+    // Files are inflated in parallel on up to maxThreads threads (1 extracts
+    // in place, one by one). maxInFlightBytes caps the uncompressed size of
+    // the entries being written at once.
+    void setMaxThreads(int maxThreads) { m_maxThreads = maxThreads; }
+    void setMaxInFlightBytes(qint64 bytes) { m_maxInFlightBytes = qMax<qint64>(1, bytes); }
+
+    // Every entry name is checked before anything is written, so an archive
+    // with a single escaping path extracts nothing. Each file is written
+    // exactly once. onEntry(index, count, name) runs on the calling thread as
+    // each entry is dispatched.
+    bool extractAll(const QString& destDir,
+                    const std::function<void(int, int, const QString&)>& onEntry = nullptr);
+    bool extract(const Entry& entry, const QString& destDir);
+
+    // Turns an archive member name into a clean relative path. Fails for
+    // absolute paths and ".." components (zip-slip), and for components
+    // Windows would not store as named: any ':' (drive letters, NTFS
+    // streams), reserved device names, trailing dots or spaces.
+    static bool sanitizeName(const QString& name, QString& relative);
+    // Inflates (or copies) one entry's data from in to out, stopping as soon as
+    // it runs past the declared size; succeeds only if size and CRC match
+    static bool inflateEntry(QIODevice& in, const Entry& entry, QIODevice& out, QString& error);
+    // Parses consecutive central directory records from the start of data
+    static bool parseCentralDirectory(const QByteArray& data, QVector<Entry>& entries, QString& error);
+
+private:
+    Q_DISABLE_COPY(ZipReader)
+
+    bool fail(const QString& message);
+    bool readCentralDirectory();
+    static qint64 dataOffset(QFile& archive, const Entry& entry);
+    static bool extractFile(QFile& archive, const Entry& entry, const QString& target, QString& error);
+
+    QFile m_file;
+    QVector<Entry> m_entries;
+    QString m_error;
+    int m_maxThreads = QThread::idealThreadCount();
+    qint64 m_maxInFlightBytes = 64 * 1024 * 1024;
+};
+
+// Extracts a ZIP archive while it is still arriving, e.g. from a network
+// reply. Local file headers are parsed as bytes are written and each entry is
+// inflated into a staging folder next to destDir. finish() checks every entry
+// against the central directory at the end and only then moves the listed
+// files into destDir, putting back any it replaced if a move fails. Until
+// then destDir is untouched; a failed or abandoned extraction just deletes
+// the staging folder.
+// Stored entries whose size is only given after the data (bit 3) can't be
+// streamed and make write() fail, so callers need a file-based fallback.
+class ZipStreamExtractor {
+public:
+    explicit ZipStreamExtractor(const QString& destDir);
+    ~ZipStreamExtractor();
+
+    void setEntryCallback(const std::function<void(const QString&)>& onEntry) { m_onEntry = onEntry; }
+
+    bool write(const QByteArray& data);
+    bool finish();
+    QString errorString() const { return m_error; }
+    int extractedCount() const { return m_done.size(); }
+
+private:
+    Q_DISABLE_COPY(ZipStreamExtractor)
+
+    enum class State { Header, Data, Descriptor, CentralDirectory, Failed };
+    struct Done {
+        QString path;           // in the staging folder
+        QString relative;       // below destDir
+        quint32 crc = 0;
+        qint64 uncompressedSize = 0;
+    };
+
+    bool fail(const QString& message);
+    bool parseHeader(int& pos);
+    bool consumeData(int& pos);
+    bool parseDescriptor(int& pos);
+    bool finishEntry(quint32 crc, qint64 compressedSize, qint64 uncompressedSize);
+    bool install(const QStringList& folders, const QVector<Done>& files);
+    void resetEntry();
+
+    QString m_destDir;
+    QString m_stagingDir;
+    QString m_backupDir;        // files replaced by install(), until it succeeds
+    std::function<void(const QString&)> m_onEntry;
+    State m_state = State::Header;
+    QByteArray m_buffer;        // bytes not consumed yet, at most a partial header
+    QByteArray m_centralDirectory;
+
+    // Entry being extracted
+    struct Current;
+    Current* m_current = nullptr;
+    QHash<QString, Done> m_done; // archive name -> extracted file
+    QString m_error;
+};
+
+#endif // ZIPREADER_H
@@ -0,0 +1,163 @@
+#include "batchinstallworker.h"
+#include "../config.h"
+#include "../utils/networkclient.h"
+#include "../utils/patchstore.h"
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QEventLoop>
+#include <QFile>
+#include <QDir>
+#include <QHash>
+#include <QSet>
+#include <functional>
+
+BatchInstallWorker::BatchInstallWorker(const QStringList& appIds, const QHash<QString, QByteArray>& expectedSha256,
+                                       int maxConcurrent, QObject* parent)
+    : QThread(parent)
+    , m_appIds(appIds)
+    , m_expectedSha256(expectedSha256)
+    , m_maxConcurrent(qMax(1, maxConcurrent))
+{
+}
+
+void BatchInstallWorker::run() {
+    try {
+        const int count = m_appIds.size();
+        const qint64 unit = 1000; // progress units per patch
+        emit log(QString("Starting batch install for %1 games (%2 at a time)...")
+                 .arg(count).arg(m_maxConcurrent), "INFO");
+
+        // ---- Patches the store already holds a verified copy of ----
+        QHash<QString, QString> cachePaths;
+        QStringList toDownload;
+        for (const QString& appId : m_appIds) {
+            QString storedPath = PatchStore::find(m_expectedSha256.value(appId));
+            if (storedPath.isEmpty()) {
+                toDownload.append(appId);
+            } else {
+                cachePaths.insert(appId, storedPath);
+            }
+        }
+        if (!cachePaths.isEmpty()) {
+            emit log(QString("Using %1 patches from the local store").arg(cachePaths.size()), "INFO");
+        }
+        emit status(QString("Downloading %1 patches...").arg(toDownload.size()));
+
+        // ---- Download phase: at most m_maxConcurrent requests in flight ----
+        QStringList failed;
+        QHash<QString, qint64> partial;
+        qint64 completedUnits = qint64(cachePaths.size()) * unit;
+        const int downloadCount = toDownload.size();
+        int next = 0;
+        int active = 0;
+
+        QObject context; // callbacks run on this thread
+        QEventLoop loop;
+
+        auto report = [&]() {
+            qint64 done = completedUnits;
+            for (qint64 value : partial) done += value;
+            emit progress(done, count * unit);
+        };
+
+        std::function<void()> startNext = [&]() {
+            while (active < m_maxConcurrent && next < downloadCount) {
+                QString appId = toDownload[next++];
+                QNetworkRequest request{QUrl(Config::luaFileUrl() + appId + ".lua")};
+                request.setTransferTimeout(30000);
+
+                active++;
+                partial.insert(appId, 0);
+                QNetworkReply* reply = NetworkClient::instance().get(request, &context,
+                    [&, appId](QNetworkReply* reply) {
+                        reply->deleteLater();
+                        active--;
+                        partial.remove(appId);
+                        completedUnits += unit;
+
+                        if (reply->error() == QNetworkReply::NoError) {
+                            QByteArray data = reply->readAll();
+                            QByteArray expected = m_expectedSha256.value(appId);
+                            QString path;
+                            if (data.isEmpty() || (!expected.isEmpty() && PatchStore::hash(data) != expected)) {
+                                failed.append(appId);
+                                emit log(QString("Patch for %1 failed verification").arg(appId), "ERROR");
+                            } else if ((path = PatchStore::store(data)).isEmpty()) {
+                                failed.append(appId);
+                                emit log(QString("Failed to write patch for %1").arg(appId), "ERROR");
+                            } else {
+                                cachePaths.insert(appId, path);
+                                emit log(QString("Downloaded patch for %1").arg(appId), "INFO");
+                            }
+                        } else {
+                            failed.append(appId);
+                            emit log(QString("Download failed for %1: %2").arg(appId, reply->errorString()), "ERROR");
+                        }
+
+                        emit status(QString("Downloaded %1 of %2 patches")
+                                    .arg(cachePaths.size() + failed.size()).arg(count));
+                        report();
+                        startNext();
+                        if (active == 0) loop.quit();
+                    });
+
+                connect(reply, &QNetworkReply::downloadProgress, &context,
+                        [&, appId](qint64 received, qint64 total) {
+                            if (total <= 0 || !partial.contains(appId)) return;
+                            partial[appId] = received * unit / total;
+                            report();
+                        });
+            }
+        };
+
+        startNext();
+        if (active > 0) loop.exec();
+
+        if (cachePaths.isEmpty()) {
+            throw std::runtime_error("None of the patches could be downloaded");
+        }
+
+        // ---- Install phase: one pass over the plugin folders ----
+        emit status("Installing patches...");
+        QStringList targetDirs = Config::getAllSteamPluginDirs();
+        if (targetDirs.isEmpty()) {
+            targetDirs.append(Config::getSteamPluginDir());
+            emit log("No plugin paths found, using default path", "WARN");
+        }
+
+        QSet<QString> installedSet;
+        for (const QString& pluginDir : targetDirs) {
+            QDir pDir(pluginDir);
+            if (!pDir.exists() && !pDir.mkpath(".")) {
+                emit log(QString("Failed to create folder: %1").arg(pluginDir), "WARN");
+                continue;
+            }
+            emit log(QString("Copying %1 patches to %2").arg(cachePaths.size()).arg(pluginDir), "INFO");
+            for (auto it = cachePaths.constBegin(); it != cachePaths.constEnd(); ++it) {
+                QString dest = pDir.filePath(it.key() + ".lua");
+                QFile::remove(dest);
+                if (QFile::copy(it.value(), dest)) installedSet.insert(it.key());
+                else emit log(QString("Failed to copy to: %1").arg(dest), "WARN");
+            }
+        }
+
+        // Keep the caller's order in the results
+        QStringList installed;
+        for (const QString& appId : m_appIds) {
+            if (installedSet.contains(appId)) installed.append(appId);
+            else if (cachePaths.contains(appId)) failed.append(appId);
+        }
+
+        if (installed.isEmpty()) {
+            throw std::runtime_error("Failed to install patches to any plugin folder");
+        }
+
+        emit log(QString("Installed %1 of %2 patches").arg(installed.size()).arg(count),
+                 failed.isEmpty() ? "SUCCESS" : "WARN");
+        emit finished(installed, failed);
+
+    } catch (const std::exception& e) {
+        emit log(QString("Batch install failed: %1").arg(e.what()), "ERROR");
+        emit error(QString::fromStdString(e.what()));
+    }
+}
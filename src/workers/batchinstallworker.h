@@ -0,0 +1,38 @@
+#ifndef BATCHINSTALLWORKER_H
+#define BATCHINSTALLWORKER_H
+
+#include <QThread>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QByteArray>
+
+// Installs Lua patches for many app ids at once: patches already in the
+// local store are reused, the rest download through a bounded queue on the
+// shared network client, then every patch is copied into the stplug-in
+// folders in a single pass.
+class BatchInstallWorker : public QThread {
+    Q_OBJECT
+
+public:
+    // expectedSha256 maps app ids to the raw digests advertised by the index
+    BatchInstallWorker(const QStringList& appIds, const QHash<QString, QByteArray>& expectedSha256,
+                       int maxConcurrent = 4, QObject* parent = nullptr);
+
+signals:
+    void finished(QStringList installed, QStringList failed);
+    void progress(qint64 done, qint64 total);
+    void status(QString message);
+    void log(QString message, QString level);  // level: INFO, SUCCESS, ERROR, WARN
+    void error(QString errorMessage);
+
+protected:
+    void run() override;
+
+private:
+    QStringList m_appIds;
+    QHash<QString, QByteArray> m_expectedSha256;
+    int m_maxConcurrent;
+};
+
+#endif // BATCHINSTALLWORKER_H
@@ -1,15 +1,11 @@
 #include "fixdownloadworker.h"
 #include "../config.h"
 #include "../utils/paths.h"
-#include <QNetworkAccessManager>
+#include "../utils/networkclient.h"
+#include "../utils/zipreader.h"
 #include <QNetworkRequest>
-#include <QNetworkReply>
-#include <QEventLoop>
 #include <QFile>
 #include <QDir>
-#include <QTimer>
-#include <QProcess>
-#include <QTemporaryFile>
 
 FixDownloadWorker::FixDownloadWorker(const QString& appId, const QString& targetPath, QObject* parent)
     : QThread(parent)
@@ -40,66 +36,70 @@ void FixDownloadWorker::run() {
         }
         
         emit log("Initializing network request...", "INFO");
-        QNetworkAccessManager manager;
         QUrl qurl{url};
         QNetworkRequest request{qurl};
-        request.setHeader(QNetworkRequest::UserAgentHeader, "SteamLuaPatcher/2.0");
-        request.setRawHeader("X-Access-Token", Config::getAccessToken().toUtf8());
         
         emit log("Connecting to server...", "INFO");
-        QEventLoop loop;
-        QNetworkReply* reply = manager.get(request);
-        
-        // Connect progress
-        connect(reply, &QNetworkReply::downloadProgress, 
-                [this](qint64 received, qint64 total) {
-                    emit progress(received, total);
-                    if (total > 0) {
-                        int percent = static_cast<int>(received * 100 / total);
-                        if (percent % 25 == 0 && received > 0) {
-                            emit log(QString("Download progress: %1%").arg(percent), "INFO");
-                        }
-                    }
-                });
-        
-        connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-        
-        QTimer timer;
-        timer.setSingleShot(true);
-        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-        timer.start(120000); // 120 second timeout for larger files
-        
-        emit log("Downloading fix zip file...", "INFO");
-        loop.exec();
-        
-        if (!timer.isActive()) {
-            emit log("Download timed out after 120 seconds", "ERROR");
-            throw std::runtime_error("Connection timed out");
+        auto onProgress = [this](qint64 received, qint64 total) {
+            emit progress(received, total);
+            if (total > 0) {
+                int percent = static_cast<int>(received * 100 / total);
+                if (percent % 25 == 0 && received > 0) {
+                    emit log(QString("Download progress: %1%").arg(percent), "INFO");
+                }
+            }
+        };
+        
+        // Fast path: inflate entries while the archive downloads. The archive is
+        // saved to the temp file as it streams, so a dropped connection resumes
+        // below and an archive that can't be streamed is extracted from disk.
+        // A partial archive from an earlier attempt is resumed through the file path instead.
+        NetworkClient::DownloadResult download;
+        if (!QFile::exists(tempPath + ".part")) {
+            if (streamFix(request, tempPath, onProgress, download)) {
+                QFile::remove(tempPath);
+                emit log("Game fix applied successfully!", "SUCCESS");
+                emit finished(m_targetPath);
+                return;
+            }
+            // HTTP errors won't go away by asking again
+            if (download.httpStatus >= 400 && download.httpStatus < 500) {
+                emit log(QString("Download failed: %1").arg(download.error), "ERROR");
+                throw std::runtime_error(download.error.toStdString());
+            }
+            if (!download.ok) emit log("Falling back to downloading the archive before extracting", "WARN");
         }
         
-        if (reply->error() != QNetworkReply::NoError) {
-            emit log(QString("Network error: %1").arg(reply->errorString()), "ERROR");
-            throw std::runtime_error(reply->errorString().toStdString());
+        // Streamed straight into the temp file; 120 second timeout for larger files.
+        // Dropped connections are retried and continue from the bytes already on disk.
+        const int maxAttempts = 3;
+        for (int attempt = 1; attempt <= maxAttempts && !download.ok; ++attempt) {
+            if (attempt == 1) emit log("Downloading fix zip file...", "INFO");
+            download = NetworkClient::instance().download(request, tempPath, 120000, onProgress);
+            if (download.resumedFrom > 0) {
+                emit log(QString("Resumed download at %1 bytes").arg(download.resumedFrom), "INFO");
+            }
+            if (download.ok) break;
+            
+            if (download.timedOut) {
+                emit log("Download timed out after 120 seconds", "WARN");
+            } else {
+                emit log(QString("Download failed: %1").arg(download.error), "WARN");
+            }
+            // HTTP errors won't go away by asking again
+            bool transient = download.timedOut || download.httpStatus == 0 || download.httpStatus >= 500;
+            if (!transient || attempt == maxAttempts) break;
+            emit status(QString("Retrying download (%1/%2)...").arg(attempt + 1).arg(maxAttempts));
+            emit log(QString("Retrying (attempt %1 of %2)...").arg(attempt + 1).arg(maxAttempts), "INFO");
         }
         
-        emit log("Download completed successfully", "SUCCESS");
-        
-        // Save to temp
-        QByteArray data = reply->readAll();
-        emit log(QString("Received %1 bytes").arg(data.size()), "INFO");
-        
-        emit log(QString("Writing temp file: %1").arg(tempPath), "INFO");
-        QFile file(tempPath);
-        if (!file.open(QIODevice::WriteOnly)) {
-            emit log("Failed to open temp file for writing", "ERROR");
-            throw std::runtime_error("Failed to write temp file");
+        if (!download.ok) {
+            emit log(QString("Download failed: %1").arg(download.error), "ERROR");
+            throw std::runtime_error(download.error.toStdString());
         }
         
-        file.write(data);
-        file.close();
-        reply->deleteLater();
-        
-        emit log("Temp file written successfully", "SUCCESS");
+        emit log("Download completed successfully", "SUCCESS");
+        emit log(QString("Wrote %1 bytes to %2").arg(download.bytes).arg(tempPath), "INFO");
         
         // Extract zip
         emit status("Extracting fix...");
@@ -123,49 +123,56 @@ void FixDownloadWorker::run() {
     }
 }
 
-bool FixDownloadWorker::extractZip(const QString& zipPath, const QString& destPath) {
-    emit log("Using PowerShell to extract zip...", "INFO");
-    
-    // Use PowerShell's Expand-Archive for Windows (built-in, no dependencies)
-    QProcess process;
+bool FixDownloadWorker::streamFix(const QNetworkRequest& request, const QString& archivePath,
+                                  const std::function<void(qint64, qint64)>& onProgress,
+                                  NetworkClient::DownloadResult& download) {
+    emit status("Downloading and extracting fix...");
+    emit log(QString("Extracting into %1 while downloading...").arg(m_targetPath), "INFO");
     
-    // Escape paths for PowerShell
-    QString escapedZip = zipPath;
-    escapedZip.replace("'", "''");
-    QString escapedDest = destPath;
-    escapedDest.replace("'", "''");
+    // Staged next to the game folder; nothing there changes unless the whole archive checks out
+    ZipStreamExtractor extractor(m_targetPath);
+    extractor.setEntryCallback([this](const QString& name) {
+        emit log(QString("Extracting: %1").arg(name), "INFO");
+    });
     
-    QStringList args;
-    args << "-NoProfile" << "-NonInteractive" << "-Command";
-    args << QString("Expand-Archive -Path '%1' -DestinationPath '%2' -Force")
-            .arg(escapedZip)
-            .arg(escapedDest);
-    
-    emit log(QString("Running: powershell %1").arg(args.join(" ")), "INFO");
-    
-    process.start("powershell.exe", args);
-    
-    if (!process.waitForStarted(10000)) {
-        emit log("Failed to start PowerShell", "ERROR");
+    download = NetworkClient::instance().stream(request, 120000,
+            [&extractor](const QByteArray& chunk) { return extractor.write(chunk); }, onProgress, archivePath);
+    if (!download.ok) {
+        emit log(QString("Streaming extraction stopped: %1").arg(download.error), "WARN");
         return false;
     }
-    
-    if (!process.waitForFinished(60000)) { // 60 second timeout
-        emit log("PowerShell extraction timed out", "ERROR");
-        process.kill();
+    if (!extractor.errorString().isEmpty()) {
+        emit log(QString("Streaming extraction stopped: %1").arg(extractor.errorString()), "WARN");
+        emit log("Extracting from the downloaded archive instead", "INFO");
+        return false;
+    }
+    if (!extractor.finish()) {
+        emit log(QString("Streaming extraction failed verification: %1").arg(extractor.errorString()), "WARN");
+        emit log("Extracting from the downloaded archive instead", "INFO");
         return false;
     }
     
-    int exitCode = process.exitCode();
-    QString stdOut = QString::fromUtf8(process.readAllStandardOutput());
-    QString stdErr = QString::fromUtf8(process.readAllStandardError());
-    
-    if (!stdOut.isEmpty()) {
-        emit log(QString("PowerShell output: %1").arg(stdOut.trimmed()), "INFO");
+    emit log(QString("Extracted %1 files from %2 downloaded bytes")
+             .arg(extractor.extractedCount()).arg(download.bytes), "SUCCESS");
+    return true;
+}
+
+bool FixDownloadWorker::extractZip(const QString& zipPath, const QString& destPath) {
+    ZipReader zip;
+    if (!zip.open(zipPath)) {
+        emit log(zip.errorString(), "ERROR");
+        return false;
     }
+    emit log(QString("Archive contains %1 entries (%2 bytes uncompressed)")
+             .arg(zip.entries().size()).arg(zip.totalUncompressedSize()), "INFO");
     
-    if (exitCode != 0) {
-        emit log(QString("PowerShell error (exit code %1): %2").arg(exitCode).arg(stdErr.trimmed()), "ERROR");
+    bool ok = zip.extractAll(destPath, [this](int index, int count, const QString& name) {
+        emit progress(index + 1, count);
+        emit status(QString("Extracting fix (%1/%2)...").arg(index + 1).arg(count));
+        emit log(QString("Extracting: %1").arg(name), "INFO");
+    });
+    if (!ok) {
+        emit log(zip.errorString(), "ERROR");
         return false;
     }
     
@@ -1,8 +1,10 @@
 #ifndef FIXDOWNLOADWORKER_H
 #define FIXDOWNLOADWORKER_H
 
+#include "../utils/networkclient.h"
 #include <QThread>
 #include <QString>
+#include <functional>
 
 class FixDownloadWorker : public QThread {
     Q_OBJECT
@@ -24,6 +26,10 @@ private:
     QString m_appId;
     QString m_targetPath;
     
+    // Leaves the transfer result in download; with download.ok the archive is at archivePath
+    bool streamFix(const QNetworkRequest& request, const QString& archivePath,
+                   const std::function<void(qint64, qint64)>& onProgress,
+                   NetworkClient::DownloadResult& download);
     bool extractZip(const QString& zipPath, const QString& destPath);
 };
 
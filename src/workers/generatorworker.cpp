@@ -1,15 +1,13 @@
 #include "generatorworker.h"
 #include "../utils/paths.h"
 #include "../config.h"
-#include <QNetworkAccessManager>
+#include "../utils/networkclient.h"
+#include "../utils/zipreader.h"
 #include <QNetworkRequest>
 #include <QNetworkReply>
-#include <QEventLoop>
 #include <QFile>
 #include <QDir>
 #include <QDirIterator>
-#include <QProcess>
-#include <QTimer>
 #include <QUrl>
 
 GeneratorWorker::GeneratorWorker(const QString& appId, QObject* parent)
@@ -54,72 +52,48 @@ void GeneratorWorker::run() {
         }
         
         emit log("Sending HTTP request...", "INFO");
-        QNetworkAccessManager manager;
         QNetworkRequest request;
         request.setUrl(QUrl(url));
         request.setHeader(QNetworkRequest::UserAgentHeader, "genshinreya");
         request.setRawHeader("Accept", "*/*");
         
-        QEventLoop loop;
-        QNetworkReply* reply = manager.get(request);
-        
-        connect(reply, &QNetworkReply::downloadProgress, 
+        // Timeout - 60 seconds for slower connections
+        NetworkClient::DownloadResult download = NetworkClient::instance().download(request, archivePath, 60000,
                 [this](qint64 received, qint64 total) {
                     emit progress(received, total);
                     if (total > 0) {
                         emit log(QString("Downloading: %1 / %2 bytes").arg(received).arg(total), "INFO");
                     }
                 });
-        connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-        
-        // Timeout - 60 seconds for slower connections
-        QTimer timer;
-        timer.setSingleShot(true);
-        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-        timer.start(60000); 
         
-        loop.exec();
-        
-        if (timer.isActive()) {
-            timer.stop();
-        } else {
+        if (download.timedOut) {
             emit log("Request timed out after 60 seconds", "ERROR");
-            reply->abort();
-            reply->deleteLater();
             throw std::runtime_error("Connection timed out");
         }
         
-        if (reply->error() != QNetworkReply::NoError) {
-            QString errorStr = reply->errorString();
-            int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-            emit log(QString("Network error (HTTP %1): %2").arg(httpStatus).arg(errorStr), "ERROR");
-            reply->deleteLater();
-            throw std::runtime_error(errorStr.toStdString());
+        if (!download.ok) {
+            emit log(QString("Network error (HTTP %1): %2").arg(download.httpStatus).arg(download.error), "ERROR");
+            throw std::runtime_error(download.error.toStdString());
         }
         
-        QByteArray data = reply->readAll();
-        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-        emit log(QString("Response received: HTTP %1, %2 bytes").arg(httpStatus).arg(data.size()), "INFO");
-        reply->deleteLater();
+        emit log(QString("Response received: HTTP %1, %2 bytes").arg(download.httpStatus).arg(download.bytes), "INFO");
         
-        if (data.isEmpty()) {
+        if (download.bytes == 0) {
+            QFile::remove(archivePath);
             emit log("Response is empty", "ERROR");
             throw std::runtime_error("Empty response from server");
         }
         
+        // Only the head of the body is needed to tell a ZIP from an error page
+        QByteArray data;
+        {
+            QFile file(archivePath);
+            if (file.open(QIODevice::ReadOnly)) data = file.read(512);
+        }
+        
         // Check if response is a ZIP (starts with PK)
         if (data.startsWith("PK")) {
-            emit log("Received ZIP archive. Saving to disk...", "INFO");
-            
-            QFile file(archivePath);
-            if (!file.open(QIODevice::WriteOnly)) {
-                emit log(QString("Failed to open file for writing: %1").arg(archivePath), "ERROR");
-                throw std::runtime_error("Failed to save zip file");
-            }
-            qint64 written = file.write(data);
-            file.close();
-            
-            emit log(QString("Archive saved: %1 bytes written to %2").arg(written).arg(archivePath), "INFO");
+            emit log(QString("Received ZIP archive: %1 bytes written to %2").arg(download.bytes).arg(archivePath), "INFO");
             
             // Create extraction directory
             QDir extractDirObj(extractDir);
@@ -130,43 +104,21 @@ void GeneratorWorker::run() {
                 }
             }
             
-            // Extract using PowerShell (Windows)
-            emit log("Extracting archive using PowerShell...", "INFO");
-            QProcess process;
-            process.setProcessChannelMode(QProcess::MergedChannels);
-            
-            // Use native path separators for Windows
-            QString nativeArchivePath = QDir::toNativeSeparators(archivePath);
-            QString nativeExtractDir = QDir::toNativeSeparators(extractDir);
-            
-            QString cmd = QString("Expand-Archive -LiteralPath '%1' -DestinationPath '%2' -Force")
-                .arg(nativeArchivePath)
-                .arg(nativeExtractDir);
-            
-            emit log(QString("PowerShell command: %1").arg(cmd), "INFO");
-            
-            process.start("powershell", QStringList() << "-NoProfile" << "-NonInteractive" << "-Command" << cmd);
-            
-            if (!process.waitForStarted(5000)) {
-                emit log("Failed to start PowerShell process", "ERROR");
-                throw std::runtime_error("Failed to start extraction process");
-            }
-            
-            if (!process.waitForFinished(30000)) {
-                emit log("Extraction process timed out", "ERROR");
-                process.kill();
-                throw std::runtime_error("Extraction timed out");
-            }
-            
-            QString processOutput = QString::fromUtf8(process.readAll());
-            if (!processOutput.isEmpty()) {
-                emit log(QString("PowerShell output: %1").arg(processOutput.trimmed()), "INFO");
+            emit log("Extracting archive...", "INFO");
+            ZipReader zip;
+            if (!zip.open(archivePath)) {
+                emit log(zip.errorString(), "ERROR");
+                throw std::runtime_error("Failed to read archive");
             }
-            
-            if (process.exitCode() != 0) {
-                emit log(QString("Extraction failed with exit code: %1").arg(process.exitCode()), "ERROR");
+            bool extracted = zip.extractAll(extractDir, [this](int index, int count, const QString& name) {
+                emit progress(index + 1, count);
+                emit log(QString("Extracting: %1").arg(name), "INFO");
+            });
+            if (!extracted) {
+                emit log(zip.errorString(), "ERROR");
                 throw std::runtime_error("Failed to extract archive");
             }
+            zip.close(); // release the archive so it can be deleted below
             
             emit log("Archive extracted successfully", "SUCCESS");
             
@@ -259,6 +211,7 @@ void GeneratorWorker::run() {
             
         } else {
             // Not a ZIP - log the response for debugging
+            QFile::remove(archivePath);
             emit log("Response is not a ZIP archive", "ERROR");
             QString preview = QString::fromUtf8(data.left(500));
             emit log(QString("Response preview: %1").arg(preview), "WARN");
@@ -1,18 +1,32 @@
 #include "indexdownloadworker.h"
 #include "../config.h"
 #include "../utils/paths.h"
-#include <QNetworkAccessManager>
+#include "../utils/binaryindex.h"
+#include "../utils/networkclient.h"
 #include <QNetworkRequest>
 #include <QNetworkReply>
-#include <QEventLoop>
-#include <QTimer>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QFile>
+#include <QSaveFile>
 #include <QDir>
+#include <QFileInfo>
+#include <QSharedPointer>
+#include <QCryptographicHash>
 #include <QUrlQuery>
-#include <QDateTime>
+#include <QHash>
+#include <algorithm>
+
+namespace {
+    // The catalogue on screen keeps the binary cache mapped, and a mapped file
+    // can't be replaced on Windows. There are two slots: a sync writes the one
+    // it didn't read, and the newer valid slot is the one opened.
+    QStringList binarySlots() {
+        QString path = Paths::getLocalBinaryIndexPath();
+        return { path, path + ".alt" };
+    }
+}
 
 IndexDownloadWorker::IndexDownloadWorker(QObject* parent)
     : QThread(parent)
@@ -22,103 +36,320 @@ IndexDownloadWorker::IndexDownloadWorker(QObject* parent)
 void IndexDownloadWorker::run() {
     try {
         emit progress("Connecting...");
-        
+
         QString cacheDir = Paths::getLocalCacheDir();
         QDir dir;
         dir.mkpath(cacheDir);
-        
+
         QString indexPath = Paths::getLocalIndexPath();
-        QJsonObject indexData;
 
-        // Explicitly remove old cache as requested
-        if (QFile::exists(indexPath)) {
-            QFile::remove(indexPath);
+        // Show the last synced library straight from the mapped binary cache
+        QString readSlot;
+        QSharedPointer<const BinaryIndex> cached = openNewestBinary(readSlot);
+        bool haveCache = !cached.isNull();
+        QByteArray cachedDigest;
+        if (haveCache) {
+            cachedDigest = cached->sourceDigest();
+            emit cacheLoaded(GameCatalogue(cached));
         }
+        QStringList slotPaths = binarySlots();
+        QString binaryPath = readSlot == slotPaths.first() ? slotPaths.last() : slotPaths.first();
 
-        // Try to download
-        emit progress("Syncing library...");
-        
-        QNetworkAccessManager manager;
-        // Add timestamp to query to prevent server-side caching
-        QString urlStr = Config::gamesIndexUrl();
-        if (urlStr.contains("?")) {
-            urlStr += "&_t=" + QString::number(QDateTime::currentMSecsSinceEpoch());
-        } else {
-            urlStr += "?_t=" + QString::number(QDateTime::currentMSecsSinceEpoch());
+        // Validators of the copy we hold; only sent when there is a copy to fall back on
+        bool haveJson = QFile::exists(indexPath);
+        QJsonObject meta;
+        if (haveCache || haveJson) {
+            QFile metaFile(Paths::getLocalIndexMetaPath());
+            if (metaFile.open(QIODevice::ReadOnly)) {
+                meta = QJsonDocument::fromJson(metaFile.readAll()).object();
+            }
         }
 
-        QUrl requestUrl{urlStr};
-        QNetworkRequest request{requestUrl};
-        request.setHeader(QNetworkRequest::UserAgentHeader, "SteamLuaPatcher/2.0");
-        request.setRawHeader("X-Access-Token", Config::getAccessToken().toUtf8());
-        request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
-        
-        QEventLoop loop;
-        QNetworkReply* reply = manager.get(request);
-        connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-        
-        QTimer timer;
-        timer.setSingleShot(true);
-        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-        timer.start(30000); // 30 second timeout
-        
-        loop.exec();
-        
-        if (reply->error() == QNetworkReply::NoError && timer.isActive()) {
-            // Download successful
+        // Try to download; with a cached copy ask the server for a patch against its version
+        emit progress("Syncing library...");
+
+        // A delta we couldn't store last time: the binary copy's version can't be trusted,
+        // so ask for the whole document without validators
+        bool fullSync = meta["full_sync"].toBool(false);
+        if (fullSync) meta = QJsonObject();
+        qint64 cachedVersion = haveCache && !fullSync ? cached->generatedAt() : 0;
+        bool timedOut = false;
+        QNetworkReply* reply = fetchIndex(cachedVersion, meta, timedOut);
+        QByteArray body;
+        bool bodyRead = false;
+
+        if (cachedVersion > 0 && reply->error() == QNetworkReply::NoError && !timedOut
+            && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
             QByteArray data = reply->readAll();
-            QJsonDocument doc = QJsonDocument::fromJson(data);
-            indexData = doc.object();
-            
-            // Save to cache
-            QFile file(indexPath);
-            if (file.open(QIODevice::WriteOnly)) {
-                file.write(doc.toJson());
-                file.close();
+            QJsonObject patch = QJsonDocument::fromJson(data).object();
+            if (patch["delta"].toBool(false)) {
+                reply->deleteLater();
+
+                QList<GameInfo> games = cached->toGameList();
+                qint64 version = 0;
+                if (applyDelta(patch, cachedVersion, games, version)) {
+                    emit progress(QString("Applying %1 index changes...")
+                        .arg(patch["added"].toArray().size() + patch["updated"].toArray().size()
+                             + patch["removed"].toArray().size()));
+
+                    bool written = false;
+                    GameCatalogue catalogue = storeBinary(binaryPath, games, version, QByteArray(), &written);
+                    if (written) {
+                        // The JSON copy and its validators describe an older full document now
+                        QFile::remove(indexPath);
+                        QFile::remove(Paths::getLocalIndexMetaPath());
+                    } else {
+                        // Disk full or the slot locked: keep the old copies to fall back on,
+                        // and have the next sync fetch the whole document
+                        requireFullSync();
+                    }
+
+                    emit finished(catalogue);
+                    return;
+                }
+
+                // Patch does not line up with our copy, start over with the full document
+                reply = fetchIndex(0, QJsonObject(), timedOut);
+            } else {
+                // Full document; keep what was already read for the common path below
+                body = data;
+                bodyRead = true;
+            }
+        }
+
+        QString errorDetails;
+        if (reply->error() == QNetworkReply::NoError && !timedOut) {
+            int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            QByteArray newEtag = reply->rawHeader("ETag");
+            QByteArray newLastModified = reply->rawHeader("Last-Modified");
+            QByteArray data = bodyRead ? body : reply->readAll();
+            reply->deleteLater();
+
+            if (statusCode == 304) {
+                if (haveCache) {
+                    emit progress("Library up to date");
+                    return;
+                }
+                // Binary cache missing or stale format: rebuild it from the JSON copy
+                QList<GameInfo> games;
+                qint64 generatedAt = 0;
+                QFile file(indexPath);
+                if (file.open(QIODevice::ReadOnly)) {
+                    QByteArray cachedData = file.readAll();
+                    file.close();
+                    if (parseIndex(cachedData, games, generatedAt)) {
+                        emit finished(storeBinary(binaryPath, games, generatedAt,
+                                                  QCryptographicHash::hash(cachedData, QCryptographicHash::Sha1)));
+                        return;
+                    }
+                }
+                errorDetails = "Server reported no changes but the local cache is unreadable";
+            } else {
+                QByteArray digest = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+                if (haveCache && digest == cachedDigest) {
+                    // Same document as the mapped cache, nothing to parse
+                    saveMeta(newEtag, newLastModified);
+                    emit progress("Library up to date");
+                    return;
+                }
+
+                // Validate before touching the last good copy
+                QList<GameInfo> games;
+                qint64 generatedAt = 0;
+                if (parseIndex(data, games, generatedAt)) {
+                    QSaveFile file(indexPath);
+                    if (file.open(QIODevice::WriteOnly)) {
+                        file.write(data);
+                        file.commit();
+                    }
+
+                    // Rewrite the binary cache into the slot that isn't mapped
+                    bool written = false;
+                    GameCatalogue catalogue = storeBinary(binaryPath, games, generatedAt, digest, &written);
+                    // Validators would let the server answer 304 over a binary copy that is still old
+                    if (written) saveMeta(newEtag, newLastModified);
+                    else requireFullSync();
+
+                    emit finished(catalogue);
+                    return;
+                }
+                errorDetails = QString("Received an invalid index (%1 bytes)").arg(data.size());
             }
         } else {
-            // Network error, try cache
-            QString errorDetails;
-            if (reply->error() != QNetworkReply::NoError) {
+            if (timedOut) {
+                errorDetails = "Connection Timed Out";
+            } else {
                 int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
                 errorDetails = QString("Network Error: %1").arg(reply->errorString());
                 if (statusCode > 0) errorDetails += QString(" (Status: %1)").arg(statusCode);
-            } else {
-                errorDetails = "Connection Timed Out";
             }
+            reply->deleteLater();
+        }
 
-            emit progress("Offline mode...");
-            QFile file(indexPath);
-            if (file.open(QIODevice::ReadOnly)) {
-                QByteArray data = file.readAll();
-                QJsonDocument doc = QJsonDocument::fromJson(data);
-                indexData = doc.object();
-                file.close();
-            } else {
-                throw std::runtime_error((errorDetails + " & No local cache").toStdString());
-            }
+        // Network error or bad document, keep serving the last good copy
+        emit progress("Offline mode...");
+        if (haveCache) {
+            // Library is already on screen from the binary cache
+            return;
+        }
+
+        QFile file(indexPath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            throw std::runtime_error((errorDetails + " & No local cache").toStdString());
         }
-        
-        reply->deleteLater();
-        
-        // Extract app IDs
-        // Extract games
         QList<GameInfo> games;
-        QJsonArray arr = indexData["games"].toArray();
-        for (const QJsonValue& val : arr) {
-            QJsonObject obj = val.toObject();
-            GameInfo game;
-            game.id = obj["id"].toString();
-            game.name = obj["name"].toString();
-            game.thumbnailUrl = ""; // Will be generated when needed
-            game.hasFix = obj["has_fix"].toBool(false);
-            games.append(game);
+        qint64 generatedAt = 0;
+        if (!parseIndex(file.readAll(), games, generatedAt)) {
+            throw std::runtime_error((errorDetails + " & Local cache is corrupt").toStdString());
         }
-        
-        emit finished(games);
+        file.close();
+
+        emit finished(GameCatalogue(games));
+
 
-        
     } catch (const std::exception& e) {
         emit error(QString::fromStdString(e.what()));
     }
 }
+
+QSharedPointer<const BinaryIndex> IndexDownloadWorker::openNewestBinary(QString& path) {
+    QStringList slotPaths = binarySlots();
+    std::sort(slotPaths.begin(), slotPaths.end(), [](const QString& a, const QString& b) {
+        return QFileInfo(a).lastModified() > QFileInfo(b).lastModified();
+    });
+    for (const QString& slotPath : slotPaths) {
+        QSharedPointer<BinaryIndex> index(new BinaryIndex);
+        if (index->open(slotPath)) {
+            path = slotPath;
+            return index;
+        }
+    }
+    path.clear();
+    return QSharedPointer<const BinaryIndex>();
+}
+
+GameCatalogue IndexDownloadWorker::storeBinary(const QString& path, const QList<GameInfo>& games,
+                                               qint64 generatedAt, const QByteArray& digest, bool* written) {
+    bool ok = BinaryIndex::write(path, games, generatedAt, digest);
+    if (written) *written = ok;
+    if (ok) {
+        // Serve the fresh copy from its mapping too rather than from the parsed rows
+        QSharedPointer<BinaryIndex> index(new BinaryIndex);
+        if (index->open(path)) return GameCatalogue(index);
+    }
+    return GameCatalogue(games);
+}
+
+QNetworkReply* IndexDownloadWorker::fetchIndex(qint64 sinceVersion, const QJsonObject& meta, bool& timedOut) {
+    QUrl requestUrl{Config::gamesIndexUrl()};
+    if (sinceVersion > 0) {
+        QUrlQuery query;
+        query.addQueryItem("since", QString::number(sinceVersion));
+        requestUrl.setQuery(query);
+    }
+
+    QNetworkRequest request{requestUrl};
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+
+    QString etag = meta["etag"].toString();
+    QString lastModified = meta["last_modified"].toString();
+    if (!etag.isEmpty()) request.setRawHeader("If-None-Match", etag.toUtf8());
+    if (!lastModified.isEmpty()) request.setRawHeader("If-Modified-Since", lastModified.toUtf8());
+
+    QNetworkReply* reply = NetworkClient::instance().get(request);
+    timedOut = !NetworkClient::waitForFinished(reply, 30000); // 30 second timeout
+    return reply;
+}
+
+bool IndexDownloadWorker::applyDelta(const QJsonObject& patch, qint64 fromVersion,
+                                     QList<GameInfo>& games, qint64& version) {
+    if (static_cast<qint64>(patch["from"].toDouble(-1)) != fromVersion) return false;
+    version = static_cast<qint64>(patch["version"].toDouble(0));
+    if (version <= 0) return false;
+
+    QHash<QString, int> rowOf;
+    rowOf.reserve(games.size());
+    for (int i = 0; i < games.size(); ++i) rowOf.insert(games[i].id, i);
+
+    QSet<QString> removed;
+    for (const QJsonValue& val : patch["removed"].toArray()) {
+        removed.insert(val.toString());
+    }
+
+    QJsonObject changes;
+    changes["games"] = patch["updated"].toArray();
+    for (const GameInfo& game : parseGames(changes)) {
+        auto it = rowOf.constFind(game.id);
+        if (it == rowOf.constEnd()) return false; // update for a game we never had
+        games[it.value()] = game;
+    }
+
+    changes["games"] = patch["added"].toArray();
+    for (const GameInfo& game : parseGames(changes)) {
+        auto it = rowOf.constFind(game.id);
+        if (it != rowOf.constEnd()) games[it.value()] = game;
+        else games.append(game);
+    }
+
+    if (!removed.isEmpty()) {
+        games.erase(std::remove_if(games.begin(), games.end(),
+                                   [&removed](const GameInfo& g) { return removed.contains(g.id); }),
+                    games.end());
+    }
+    return !games.isEmpty();
+}
+
+bool IndexDownloadWorker::parseIndex(const QByteArray& data, QList<GameInfo>& games, qint64& generatedAt) {
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) return false;
+
+    QJsonObject indexData = doc.object();
+    if (!indexData["games"].isArray()) return false;
+
+    games = parseGames(indexData);
+    generatedAt = static_cast<qint64>(indexData["last_updated"].toDouble(0));
+    return !games.isEmpty();
+}
+
+QList<GameInfo> IndexDownloadWorker::parseGames(const QJsonObject& indexData) {
+    QList<GameInfo> games;
+    QJsonArray arr = indexData["games"].toArray();
+    games.reserve(arr.size());
+    for (const QJsonValue& val : arr) {
+        QJsonObject obj = val.toObject();
+        GameInfo game;
+        game.id = obj["id"].toString();
+        game.name = obj["name"].toString();
+        game.thumbnailUrl = ""; // Will be generated when needed
+        game.hasFix = obj["has_fix"].toBool(false);
+        game.sha256 = QByteArray::fromHex(obj["sha256"].toString().toLatin1());
+        if (game.sha256.size() != 32) game.sha256.clear();
+        if (game.id.isEmpty()) continue;
+        games.append(game);
+    }
+    return games;
+}
+
+void IndexDownloadWorker::requireFullSync() {
+    QJsonObject meta;
+    meta["full_sync"] = true;
+
+    QSaveFile file(Paths::getLocalIndexMetaPath());
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(meta).toJson(QJsonDocument::Compact));
+        file.commit();
+    }
+}
+
+void IndexDownloadWorker::saveMeta(const QByteArray& etag, const QByteArray& lastModified) {
+    QJsonObject meta;
+    meta["etag"] = QString::fromLatin1(etag);
+    meta["last_modified"] = QString::fromLatin1(lastModified);
+
+    QSaveFile file(Paths::getLocalIndexMetaPath());
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(meta).toJson(QJsonDocument::Compact));
+        file.commit();
+    }
+}
@@ -4,8 +4,14 @@
 #include <QThread>
 #include <QSet>
 #include "../utils/gameinfo.h"
+#include "../utils/gamecatalogue.h"
 
 #include <QString>
+#include <QJsonObject>
+#include <QSharedPointer>
+
+class QNetworkReply;
+class BinaryIndex;
 
 class IndexDownloadWorker : public QThread {
     Q_OBJECT
@@ -14,13 +20,30 @@ public:
     explicit IndexDownloadWorker(QObject* parent = nullptr);
 
 signals:
-    void finished(QList<GameInfo> games);
+    void cacheLoaded(GameCatalogue catalogue);
+    void finished(GameCatalogue catalogue);
 
     void progress(QString message);
     void error(QString errorMessage);
 
 protected:
     void run() override;
+
+private:
+    // Newest of the two binary cache slots that opens; path is set to it
+    static QSharedPointer<const BinaryIndex> openNewestBinary(QString& path);
+    // Writes the binary cache and returns the catalogue mapped from it, or
+    // built from the rows when the file can't be written or mapped
+    static GameCatalogue storeBinary(const QString& path, const QList<GameInfo>& games,
+                                     qint64 generatedAt, const QByteArray& digest, bool* written = nullptr);
+    static QNetworkReply* fetchIndex(qint64 sinceVersion, const QJsonObject& meta, bool& timedOut);
+    static bool applyDelta(const QJsonObject& patch, qint64 fromVersion,
+                           QList<GameInfo>& games, qint64& version);
+    static bool parseIndex(const QByteArray& data, QList<GameInfo>& games, qint64& generatedAt);
+    static QList<GameInfo> parseGames(const QJsonObject& indexData);
+    static void saveMeta(const QByteArray& etag, const QByteArray& lastModified);
+    // Drops the stored validators so the next sync asks for the full index
+    static void requireFullSync();
 };
 
 #endif // INDEXDOWNLOADWORKER_H
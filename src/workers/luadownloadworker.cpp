@@ -1,17 +1,14 @@
 #include "luadownloadworker.h"
 #include "../config.h"
-#include "../utils/paths.h"
-#include <QNetworkAccessManager>
+#include "../utils/networkclient.h"
+#include "../utils/patchstore.h"
 #include <QNetworkRequest>
 #include <QNetworkReply>
-#include <QEventLoop>
-#include <QFile>
-#include <QDir>
-#include <QTimer>
 
-LuaDownloadWorker::LuaDownloadWorker(const QString& appId, QObject* parent)
+LuaDownloadWorker::LuaDownloadWorker(const QString& appId, const QByteArray& expectedSha256, QObject* parent)
     : QThread(parent)
     , m_appId(appId)
+    , m_expectedSha256(expectedSha256)
 {
 }
 
@@ -22,29 +19,27 @@ void LuaDownloadWorker::run() {
         
         // Build URL
         QString url = Config::luaFileUrl() + m_appId + ".lua";
-        QString cachePath = QDir(Paths::getLocalCacheDir()).filePath(m_appId + ".lua");
         
         emit log(QString("Target App ID: %1").arg(m_appId), "INFO");
         emit log(QString("Download URL: %1").arg(url), "INFO");
-        emit log(QString("Cache path: %1").arg(cachePath), "INFO");
         
-        // Ensure cache directory exists
-        QDir cacheDir(Paths::getLocalCacheDir());
-        if (!cacheDir.exists()) {
-            emit log("Creating cache directory...", "INFO");
-            cacheDir.mkpath(".");
+        // The index names the exact patch, so a verified local copy is as good as a download
+        if (!m_expectedSha256.isEmpty()) {
+            QString storedPath = PatchStore::find(m_expectedSha256);
+            if (!storedPath.isEmpty()) {
+                emit log(QString("Using verified local copy: %1").arg(storedPath), "SUCCESS");
+                emit progress(1, 1);
+                emit finished(storedPath);
+                return;
+            }
         }
         
         emit log("Initializing network request...", "INFO");
-        QNetworkAccessManager manager;
         QUrl qurl{url};
         QNetworkRequest request{qurl};
-        request.setHeader(QNetworkRequest::UserAgentHeader, "SteamLuaPatcher/2.0");
-        request.setRawHeader("X-Access-Token", Config::getAccessToken().toUtf8());
         
         emit log("Connecting to server...", "INFO");
-        QEventLoop loop;
-        QNetworkReply* reply = manager.get(request);
+        QNetworkReply* reply = NetworkClient::instance().get(request);
         
         // Connect progress
         connect(reply, &QNetworkReply::downloadProgress, 
@@ -58,45 +53,48 @@ void LuaDownloadWorker::run() {
                     }
                 });
         
-        connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-        
-        QTimer timer;
-        timer.setSingleShot(true);
-        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-        timer.start(30000); // 30 second timeout
-        
         emit log("Downloading Lua patch file...", "INFO");
-        loop.exec();
-        
-        if (!timer.isActive()) {
+        if (!NetworkClient::waitForFinished(reply, 30000)) { // 30 second timeout
+            reply->deleteLater();
             emit log("Download timed out after 30 seconds", "ERROR");
             throw std::runtime_error("Connection timed out");
         }
         
         if (reply->error() != QNetworkReply::NoError) {
-            emit log(QString("Network error: %1").arg(reply->errorString()), "ERROR");
-            throw std::runtime_error(reply->errorString().toStdString());
+            QString errorStr = reply->errorString();
+            reply->deleteLater();
+            emit log(QString("Network error: %1").arg(errorStr), "ERROR");
+            throw std::runtime_error(errorStr.toStdString());
         }
         
         emit log("Download completed successfully", "SUCCESS");
         
-        // Save to cache
         QByteArray data = reply->readAll();
+        reply->deleteLater();
         emit log(QString("Received %1 bytes").arg(data.size()), "INFO");
         
-        emit log(QString("Writing to cache: %1").arg(cachePath), "INFO");
-        QFile file(cachePath);
-        if (!file.open(QIODevice::WriteOnly)) {
-            emit log("Failed to open cache file for writing", "ERROR");
-            throw std::runtime_error("Failed to write cache file");
+        if (data.isEmpty()) {
+            emit log("Server returned an empty patch file", "ERROR");
+            throw std::runtime_error("Empty patch file");
         }
         
-        file.write(data);
-        file.close();
-        reply->deleteLater();
+        // Catch corrupted or truncated downloads before they reach Steam
+        QByteArray digest = PatchStore::hash(data);
+        if (!m_expectedSha256.isEmpty() && digest != m_expectedSha256) {
+            emit log(QString("Checksum mismatch: expected %1, got %2")
+                     .arg(QString::fromLatin1(m_expectedSha256.toHex()), QString::fromLatin1(digest.toHex())), "ERROR");
+            throw std::runtime_error("Downloaded patch failed verification");
+        }
+        emit log(QString("SHA-256: %1").arg(QString::fromLatin1(digest.toHex())), "INFO");
+        
+        QString storedPath = PatchStore::store(data);
+        if (storedPath.isEmpty()) {
+            emit log("Failed to write patch to the local store", "ERROR");
+            throw std::runtime_error("Failed to write cache file");
+        }
         
-        emit log("Cache file written successfully", "SUCCESS");
-        emit finished(cachePath);
+        emit log(QString("Stored patch: %1").arg(storedPath), "SUCCESS");
+        emit finished(storedPath);
         
     } catch (const std::exception& e) {
         emit log(QString("Error: %1").arg(e.what()), "ERROR");
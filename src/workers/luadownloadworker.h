@@ -3,15 +3,19 @@
 
 #include <QThread>
 #include <QString>
+#include <QByteArray>
 
 class LuaDownloadWorker : public QThread {
     Q_OBJECT
 
 public:
-    explicit LuaDownloadWorker(const QString& appId, QObject* parent = nullptr);
+    // expectedSha256 is the raw digest from the index; when set, a matching copy in the
+    // patch store is used without downloading and a download must match it
+    explicit LuaDownloadWorker(const QString& appId, const QByteArray& expectedSha256 = QByteArray(),
+                               QObject* parent = nullptr);
 
 signals:
-    void finished(QString cachePath);
+    void finished(QString storePath);
     void progress(qint64 downloaded, qint64 total);
     void status(QString message);
     void log(QString message, QString level);  // level: INFO, SUCCESS, ERROR, WARN
@@ -22,6 +26,7 @@ protected:
 
 private:
     QString m_appId;
+    QByteArray m_expectedSha256;
 };
 
 #endif // LUADOWNLOADWORKER_H
@@ -0,0 +1,12 @@
+#include "searchindexworker.h"
+
+SearchIndexWorker::SearchIndexWorker(const GameCatalogue& catalogue, int generation, QObject* parent)
+    : QThread(parent)
+    , m_catalogue(catalogue)
+    , m_generation(generation)
+{
+}
+
+void SearchIndexWorker::run() {
+    emit finished(SearchIndex::build(m_catalogue), m_generation);
+}
@@ -0,0 +1,25 @@
+#ifndef SEARCHINDEXWORKER_H
+#define SEARCHINDEXWORKER_H
+
+#include <QThread>
+#include "../utils/gamecatalogue.h"
+#include "../utils/searchindex.h"
+
+class SearchIndexWorker : public QThread {
+    Q_OBJECT
+
+public:
+    SearchIndexWorker(const GameCatalogue& catalogue, int generation, QObject* parent = nullptr);
+
+signals:
+    void finished(SearchIndex index, int generation);
+
+protected:
+    void run() override;
+
+private:
+    GameCatalogue m_catalogue;
+    int m_generation;
+};
+
+#endif // SEARCHINDEXWORKER_H
@@ -5,7 +5,13 @@ Flask application to serve Lua files for the Steam Lua Patcher desktop app.
 
 from flask import Flask, send_from_directory, jsonify, abort, request, Response
 import os
+import json
+import re
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor, wait
 from functools import wraps
+import requests
 from dotenv import load_dotenv
 
 # Load environment variables from .env file
@@ -201,19 +207,204 @@ def serve_fix(filename):
     return send_from_directory(FIX_FILES_DIR, filename, mimetype='application/zip')
 
 
+def build_index_delta(base_dir, since):
+    """Compose index_changes.json entries from `since` up to the current index.
+
+    Returns None when the chain from `since` is not available, in which case
+    the caller falls back to the full document.
+    """
+    changes_path = os.path.join(base_dir, 'index_changes.json')
+    if not os.path.exists(changes_path):
+        return None
+    try:
+        with open(changes_path, 'r', encoding='utf-8') as f:
+            log = json.load(f)
+    except Exception:
+        return None
+    
+    current = log.get('current')
+    if current is None:
+        return None
+    
+    by_from = {c['from']: c for c in log.get('changes', [])}
+    net = {}  # id -> (op, entry) relative to the client's copy
+    version = since
+    while version != current:
+        change = by_from.get(version)
+        if change is None:
+            return None
+        for game in change.get('added', []):
+            prev = net.get(game['id'])
+            net[game['id']] = ('updated' if prev and prev[0] == 'removed' else 'added', game)
+        for game in change.get('updated', []):
+            prev = net.get(game['id'])
+            net[game['id']] = ('added' if prev and prev[0] == 'added' else 'updated', game)
+        for game_id in change.get('removed', []):
+            prev = net.get(game_id)
+            if prev and prev[0] == 'added':
+                del net[game_id]
+            else:
+                net[game_id] = ('removed', None)
+        version = change['to']
+    
+    return {
+        'delta': True,
+        'from': since,
+        'version': current,
+        'added': [g for op, g in net.values() if op == 'added'],
+        'updated': [g for op, g in net.values() if op == 'updated'],
+        'removed': [gid for gid, (op, _) in net.items() if op == 'removed']
+    }
+
+
 @app.route('/api/games_index.json')
 @require_token
 def serve_index():
-    """Serve the games index JSON file"""
+    """Serve the games index JSON file, or a patch against ?since=<last_updated>"""
     base_dir = os.path.dirname(os.path.abspath(__file__))
     index_path = os.path.join(base_dir, 'games_index.json')
     
+    since = request.args.get('since', type=int)
+    if since is not None:
+        delta = build_index_delta(base_dir, since)
+        if delta is not None:
+            if delta['version'] == since:
+                return Response(status=304)
+            response = jsonify(delta)
+            response.headers['Cache-Control'] = 'no-cache'
+            return response
+    
     if os.path.exists(index_path):
-        return send_from_directory(base_dir, 'games_index.json', mimetype='application/json')
+        # send_from_directory answers conditional requests (ETag / Last-Modified)
+        # with 304 so unchanged clients skip the download entirely.
+        response = send_from_directory(base_dir, 'games_index.json', mimetype='application/json')
+        response.headers['Cache-Control'] = 'no-cache'
+        return response
     
     abort(404, description="games_index.json not found. Run generate_index.py first.")
 
 
+# ---- Batched name lookup ----
+# Local stand-in for the /api/names endpoint in netlify/functions/api.js; same
+# request and answer. Names come from the index, then an in-process cache,
+# then the Steam store with SteamSpy as fallback. A null name means neither
+# service knows the app; ids left out could not be looked up right now.
+# Upstream lookups for a request start only until NAME_LOOKUP_DEADLINE_SECS
+# has passed, and the answer goes out then with whatever is done; lookups
+# still running only fill the cache for the client's next ask. The pool is
+# wide enough for a full page of misses to finish well within the deadline.
+MAX_NAME_IDS = 200
+NAME_LOOKUP_CONCURRENCY = 32
+NAME_LOOKUP_DEADLINE_SECS = 6
+NAME_FOUND_TTL_SECS = 7 * 24 * 3600
+NAME_MISSING_TTL_SECS = 6 * 3600
+# NAME_LOOKUP_UPSTREAM=0 answers from the index and cache only (offline testing)
+NAME_LOOKUP_UPSTREAM = os.environ.get('NAME_LOOKUP_UPSTREAM', '1') != '0'
+
+_name_cache = {}  # id -> (name, fetched_at)
+_name_cache_lock = threading.Lock()
+_name_pool = ThreadPoolExecutor(max_workers=NAME_LOOKUP_CONCURRENCY)
+_index_names = {'mtime': None, 'names': {}}
+
+
+def _is_real_name(name, app_id):
+    return bool(name) and name != app_id and not name.startswith('Unknown Game')
+
+
+def _get_index_names():
+    index_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'games_index.json')
+    try:
+        mtime = os.path.getmtime(index_path)
+        if _index_names['mtime'] != mtime:
+            with open(index_path, 'r', encoding='utf-8') as f:
+                games = json.load(f).get('games', [])
+            _index_names['names'] = {g['id']: g['name'] for g in games if _is_real_name(g.get('name'), g.get('id'))}
+            _index_names['mtime'] = mtime
+    except Exception:
+        pass
+    return _index_names['names']
+
+
+def _cached_name(app_id):
+    """Returns (hit, name); name is None for a remembered miss"""
+    with _name_cache_lock:
+        entry = _name_cache.get(app_id)
+        if entry is None:
+            return False, None
+        name, fetched_at = entry
+        ttl = NAME_MISSING_TTL_SECS if name is None else NAME_FOUND_TTL_SECS
+        if time.time() - fetched_at > ttl:
+            del _name_cache[app_id]
+            return False, None
+        return True, name
+
+
+def _lookup_upstream_name(app_id, deadline):
+    """Returns (answered, name) and caches answers; answered is False when a service could not be reached"""
+    if time.time() >= deadline:
+        return False, None  # still queued when its request answered
+    headers = {'User-Agent': 'SteamLuaPatcher/2.0'}
+    try:
+        store = requests.get(f'https://store.steampowered.com/api/appdetails?appids={app_id}&filters=basic',
+                             headers=headers, timeout=8)
+        store.raise_for_status()
+        entry = (store.json() or {}).get(app_id) or {}
+        name = entry['data']['name'] if entry.get('success') and entry.get('data', {}).get('name') else None
+        if name is None:
+            spy = requests.get(f'https://steamspy.com/api.php?request=appdetails&appid={app_id}',
+                               headers=headers, timeout=8)
+            spy.raise_for_status()
+            name = (spy.json() or {}).get('name') or None
+    except Exception:
+        return False, None
+    with _name_cache_lock:
+        _name_cache[app_id] = (name, time.time())
+    return True, name
+
+
+@app.route('/api/names')
+@require_token
+def resolve_names():
+    """Resolve many app ids to store names in one request: ?ids=10,20,30"""
+    ids = []
+    for part in request.args.get('ids', '').split(','):
+        part = part.strip()
+        if re.fullmatch(r'\d+', part) and part not in ids:
+            ids.append(part)
+    if not ids:
+        return jsonify({'error': 'Bad Request', 'message': 'ids must list numeric app ids'}), 400
+    if len(ids) > MAX_NAME_IDS:
+        return jsonify({'error': 'Bad Request', 'message': f'At most {MAX_NAME_IDS} ids per request'}), 400
+
+    names = {}
+    misses = []
+    index = _get_index_names()
+    for app_id in ids:
+        if app_id in index:
+            names[app_id] = index[app_id]
+            continue
+        hit, name = _cached_name(app_id)
+        if hit:
+            names[app_id] = name
+        else:
+            misses.append(app_id)
+
+    if NAME_LOOKUP_UPSTREAM and misses:
+        deadline = time.time() + NAME_LOOKUP_DEADLINE_SECS
+        futures = {_name_pool.submit(_lookup_upstream_name, app_id, deadline): app_id for app_id in misses}
+        done, _ = wait(futures, timeout=NAME_LOOKUP_DEADLINE_SECS)
+        for future in done:
+            answered, name = future.result()
+            if answered:
+                names[futures[future]] = name
+
+    response = jsonify({'names': names})
+    # A partial answer must not be served again from a cache
+    complete = len(names) == len(ids)
+    response.headers['Cache-Control'] = 'private, max-age=3600' if complete else 'no-store'
+    return response
+
+
 @app.route('/api/check/<app_id>')
 @require_token
 def check_availability(app_id):
@@ -10,6 +10,7 @@ Usage:
 
 import os
 import json
+import hashlib
 import requests
 import time
 import signal
@@ -28,6 +29,9 @@ MAX_WORKERS = 10          # Number of parallel requests (increase for faster, de
 REQUEST_DELAY = 0.1       # Delay between batches (seconds) - reduce for faster
 BATCH_SIZE = 10           # How many to process before small delay
 
+# Number of index generations kept in index_changes.json for delta sync
+MAX_INDEX_CHANGES = 30
+
 # Global variables for graceful shutdown on CTRL+C
 _progress_file = None
 _extracted_names = {}
@@ -36,6 +40,14 @@ _current_app_map = {}
 _lock = threading.Lock()  # Thread-safe access to shared data
 _stop_flag = False        # Flag to stop all threads
 
+def file_sha256(path):
+    """Hex SHA-256 of a file; clients use it to verify and dedupe patches."""
+    digest = hashlib.sha256()
+    with open(path, 'rb') as f:
+        for chunk in iter(lambda: f.read(65536), b''):
+            digest.update(chunk)
+    return digest.hexdigest()
+
 def save_games_index(app_map):
     """Generate and write the games_index.json file."""
     games_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'games')
@@ -64,7 +76,8 @@ def save_games_index(app_map):
                 games_list.append({
                     "id": app_id,
                     "name": name,
-                    "has_fix": app_id in fix_files
+                    "has_fix": app_id in fix_files,
+                    "sha256": file_sha256(os.path.join(games_dir, filename))
                 })
                 added_ids.add(app_id)
     
@@ -88,6 +101,7 @@ def save_games_index(app_map):
     }
     
     output_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'games_index.json')
+    record_index_changes(output_path, index_data)
     try:
         with open(output_path, 'w', encoding='utf-8') as f:
             json.dump(index_data, f, ensure_ascii=False, separators=(',', ':'))
@@ -97,6 +111,60 @@ def save_games_index(app_map):
         print(f"Error writing index file: {e}")
         return None
 
+def record_index_changes(index_path, index_data):
+    """Append the diff against the previous index to index_changes.json.
+
+    The server composes these entries into a single add/remove/update patch
+    for clients that send ?since=<last_updated> of the copy they hold.
+    """
+    changes_path = os.path.join(os.path.dirname(index_path), 'index_changes.json')
+    
+    previous = None
+    if os.path.exists(index_path):
+        try:
+            with open(index_path, 'r', encoding='utf-8') as f:
+                previous = json.load(f)
+        except Exception as e:
+            print(f"Could not load previous index for change log: {e}")
+    
+    changes = []
+    if os.path.exists(changes_path):
+        try:
+            with open(changes_path, 'r', encoding='utf-8') as f:
+                changes = json.load(f).get('changes', [])
+        except Exception as e:
+            print(f"Could not load change log, starting a new one: {e}")
+    
+    version = index_data['last_updated']
+    if previous and previous.get('last_updated') and previous['last_updated'] < version:
+        old_games = {g['id']: g for g in previous.get('games', [])}
+        new_games = {g['id']: g for g in index_data['games']}
+        
+        added = [g for gid, g in new_games.items() if gid not in old_games]
+        removed = [gid for gid in old_games if gid not in new_games]
+        updated = [g for gid, g in new_games.items()
+                   if gid in old_games and old_games[gid] != g]
+        
+        changes.append({
+            'from': previous['last_updated'],
+            'to': version,
+            'added': added,
+            'removed': removed,
+            'updated': updated
+        })
+        print(f"Index changes: +{len(added)} -{len(removed)} ~{len(updated)}")
+    elif previous is None:
+        # No base to diff against; older clients will get the full document
+        changes = []
+    
+    changes = changes[-MAX_INDEX_CHANGES:]
+    try:
+        with open(changes_path, 'w', encoding='utf-8') as f:
+            json.dump({'current': version, 'changes': changes}, f,
+                      ensure_ascii=False, separators=(',', ':'))
+    except Exception as e:
+        print(f"Error writing change log: {e}")
+
 def signal_handler(signum, frame):
     """Handle CTRL+C by saving progress and exiting gracefully."""
     global _stop_flag
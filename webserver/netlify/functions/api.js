@@ -22,6 +22,7 @@ if (!ACCESS_TOKEN || !ADMIN_PASSWORD) {
 const GAMES_DIR = path.join(__dirname, '../../games');
 const FIX_FILES_DIR = path.join(__dirname, '../../game-fix-files');
 const INDEX_JSON = path.join(__dirname, '../../games_index.json');
+const INDEX_CHANGES_JSON = path.join(__dirname, '../../index_changes.json');
 
 // Middleware to check access token
 const requireToken = (req, res, next) => {
@@ -200,17 +201,201 @@ app.get('/fix/:filename', requireToken, (req, res) => {
     });
 });
 
+// Compose index_changes.json entries from `since` up to the current index.
+// Returns null when the chain is not available so the caller sends the full file.
+const buildIndexDelta = (since) => {
+    if (!fs.existsSync(INDEX_CHANGES_JSON)) return null;
+    let log;
+    try {
+        log = JSON.parse(fs.readFileSync(INDEX_CHANGES_JSON, 'utf8'));
+    } catch (e) {
+        return null;
+    }
+    if (log.current === undefined) return null;
+
+    const byFrom = new Map((log.changes || []).map(c => [c.from, c]));
+    const net = new Map(); // id -> { op, game } relative to the client's copy
+    let version = since;
+    while (version !== log.current) {
+        const change = byFrom.get(version);
+        if (!change) return null;
+        for (const game of change.added || []) {
+            const prev = net.get(game.id);
+            net.set(game.id, { op: prev && prev.op === 'removed' ? 'updated' : 'added', game });
+        }
+        for (const game of change.updated || []) {
+            const prev = net.get(game.id);
+            net.set(game.id, { op: prev && prev.op === 'added' ? 'added' : 'updated', game });
+        }
+        for (const id of change.removed || []) {
+            const prev = net.get(id);
+            if (prev && prev.op === 'added') net.delete(id);
+            else net.set(id, { op: 'removed', game: null });
+        }
+        version = change.to;
+    }
+
+    const entries = [...net.entries()];
+    return {
+        delta: true,
+        from: since,
+        version: log.current,
+        added: entries.filter(([, e]) => e.op === 'added').map(([, e]) => e.game),
+        updated: entries.filter(([, e]) => e.op === 'updated').map(([, e]) => e.game),
+        removed: entries.filter(([, e]) => e.op === 'removed').map(([id]) => id)
+    };
+};
+
 app.get('/api/games_index.json', requireToken, (req, res) => {
+    if (req.query.since !== undefined) {
+        const since = parseInt(req.query.since, 10);
+        const delta = Number.isNaN(since) ? null : buildIndexDelta(since);
+        if (delta) {
+            if (delta.version === since) return res.status(304).end();
+            res.set('Cache-Control', 'no-cache');
+            return res.json(delta);
+        }
+    }
+
     if (fs.existsSync(INDEX_JSON)) {
+        // Clients revalidate with If-None-Match / If-Modified-Since; sendFile
+        // answers 304 when their copy is current. no-cache keeps CDNs from
+        // serving a stale index without asking.
         return res.sendFile(INDEX_JSON, {
             headers: {
-                'Content-Type': 'application/json'
+                'Content-Type': 'application/json',
+                'Cache-Control': 'no-cache'
             }
         });
     }
     res.status(404).send("games_index.json not found. Run generate_index.py first.");
 });
 
+// ---- Batched name lookup ----
+// One request resolves a whole page of app ids. Names come from the index
+// when it has a real one, then from a cache shared by everything this function
+// instance serves, and only then from the Steam store (SteamSpy as fallback).
+// A null name means neither service knows the app; ids missing from the
+// answer could not be looked up right now and may be asked for again.
+// Upstream lookups for a request start only until NAME_LOOKUP_DEADLINE_MS
+// has passed, and the answer goes out then with whatever is done; lookups
+// still running only fill the cache for the next ask. The concurrency is
+// high enough for a full page of misses to finish well within the deadline.
+const MAX_NAME_IDS = 200;
+const NAME_LOOKUP_CONCURRENCY = 32;
+const NAME_LOOKUP_DEADLINE_MS = 6000;
+const NAME_FOUND_TTL_MS = 7 * 24 * 3600 * 1000;
+const NAME_MISSING_TTL_MS = 6 * 3600 * 1000;
+// NAME_LOOKUP_UPSTREAM=0 answers from the index and cache only (offline testing)
+const NAME_LOOKUP_UPSTREAM = process.env.NAME_LOOKUP_UPSTREAM !== '0';
+
+const nameCache = new Map(); // id -> { name, at }
+let indexNames = null;
+let indexNamesMtime = 0;
+
+const isRealName = (name, id) => !!name && name !== id && !name.startsWith('Unknown Game');
+
+const getIndexNames = () => {
+    try {
+        const mtime = fs.statSync(INDEX_JSON).mtimeMs;
+        if (!indexNames || mtime !== indexNamesMtime) {
+            const data = JSON.parse(fs.readFileSync(INDEX_JSON, 'utf8'));
+            indexNames = new Map();
+            for (const game of data.games || []) {
+                if (isRealName(game.name, game.id)) indexNames.set(game.id, game.name);
+            }
+            indexNamesMtime = mtime;
+        }
+    } catch (e) {
+        indexNames = indexNames || new Map();
+    }
+    return indexNames;
+};
+
+const cachedName = (id) => {
+    const entry = nameCache.get(id);
+    if (!entry) return undefined;
+    const ttl = entry.name === null ? NAME_MISSING_TTL_MS : NAME_FOUND_TTL_MS;
+    if (Date.now() - entry.at > ttl) {
+        nameCache.delete(id);
+        return undefined;
+    }
+    return entry.name;
+};
+
+const fetchJson = async (url) => {
+    const response = await fetch(url, {
+        headers: { 'User-Agent': 'SteamLuaPatcher/2.0' },
+        signal: AbortSignal.timeout(8000)
+    });
+    if (!response.ok) throw new Error(`HTTP ${response.status}`);
+    return response.json();
+};
+
+// Resolves to the name, null when both services answered without one,
+// or undefined when a service could not be reached. Answers are cached.
+const lookupUpstreamName = async (id) => {
+    let name = null;
+    try {
+        const store = await fetchJson(`https://store.steampowered.com/api/appdetails?appids=${id}&filters=basic`);
+        const entry = store && store[id];
+        if (entry && entry.success && entry.data && entry.data.name) {
+            name = entry.data.name;
+        } else {
+            const spy = await fetchJson(`https://steamspy.com/api.php?request=appdetails&appid=${id}`);
+            name = spy && spy.name ? spy.name : null;
+        }
+    } catch (e) {
+        return undefined;
+    }
+    nameCache.set(id, { name, at: Date.now() });
+    return name;
+};
+
+app.get('/api/names', requireToken, async (req, res) => {
+    const ids = [...new Set(String(req.query.ids || '').split(',').map(s => s.trim()).filter(s => /^\d+$/.test(s)))];
+    if (ids.length === 0) return res.status(400).json({ error: 'Bad Request', message: 'ids must list numeric app ids' });
+    if (ids.length > MAX_NAME_IDS) return res.status(400).json({ error: 'Bad Request', message: `At most ${MAX_NAME_IDS} ids per request` });
+
+    const names = {};
+    const misses = [];
+    const index = getIndexNames();
+    for (const id of ids) {
+        if (index.has(id)) {
+            names[id] = index.get(id);
+            continue;
+        }
+        const cached = cachedName(id);
+        if (cached !== undefined) names[id] = cached;
+        else misses.push(id);
+    }
+
+    if (NAME_LOOKUP_UPSTREAM && misses.length > 0) {
+        const deadline = Date.now() + NAME_LOOKUP_DEADLINE_MS;
+        let next = 0;
+        let answering = true;
+        const worker = async () => {
+            while (next < misses.length && Date.now() < deadline) {
+                const id = misses[next++];
+                const name = await lookupUpstreamName(id);
+                if (name !== undefined && answering) names[id] = name;
+            }
+        };
+        let timer;
+        await Promise.race([
+            Promise.all(Array.from({ length: Math.min(NAME_LOOKUP_CONCURRENCY, misses.length) }, worker)),
+            new Promise(resolve => { timer = setTimeout(resolve, NAME_LOOKUP_DEADLINE_MS); })
+        ]);
+        clearTimeout(timer);
+        answering = false;
+    }
+
+    // A partial answer must not be served again from a cache
+    const complete = Object.keys(names).length === ids.length;
+    res.set('Cache-Control', complete ? 'private, max-age=3600' : 'no-store');
+    res.json({ names });
+});
+
 app.get('/api/check/:app_id', requireToken, (req, res) => {
     const appId = req.params.app_id;
     const filePath = path.join(GAMES_DIR, `${appId}.lua`);